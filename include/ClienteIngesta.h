@@ -0,0 +1,219 @@
+/**
+ * @file ClienteIngesta.h
+ * @brief Cliente que reproduce tramas hacia ServidorIngesta (pasarela simulada)
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef CLIENTE_INGESTA_H
+#define CLIENTE_INGESTA_H
+
+#include "GeneradorCarga.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <string>
+
+/**
+ * @class ClienteIngesta
+ * @brief Una conexión TCP o UDP con el servidor de ingesta
+ *
+ * Envía tramas generadas o leídas de un archivo y mide la latencia con
+ * PING/PONG: como el servidor responde en orden, el PONG llega después
+ * de que leyó todas las tramas anteriores de la conexión. Las que no
+ * traen marca ya están en la lista; las que sí, si el servidor reordena,
+ * pueden seguir retenidas en ReordenadorLecturas, así que para ellas el
+ * PONG mide la recepción y no la llegada a la lista.
+ */
+class ClienteIngesta {
+private:
+    int fd;                     ///< Socket (-1 = desconectado)
+    bool datagramas;            ///< true = UDP
+    char recibido[256];         ///< Respuestas recibidas aún sin consumir
+    std::size_t usados;         ///< Bytes válidos en recibido
+
+    ClienteIngesta(const ClienteIngesta&);
+    ClienteIngesta& operator=(const ClienteIngesta&);
+
+public:
+    static const std::size_t MAXIMO_DATAGRAMA = 1400;  ///< Bytes por datagrama UDP
+
+    /**
+     * @brief Constructor (sin conectar)
+     */
+    ClienteIngesta() : fd(-1), datagramas(false), usados(0) {}
+
+    /**
+     * @brief Destructor: cierra el socket
+     */
+    ~ClienteIngesta() {
+        cerrar();
+    }
+
+    /**
+     * @brief Conecta con el servidor en 127.0.0.1
+     * @param puerto Puerto del servidor
+     * @param udp true = UDP, false = TCP
+     * @return true si se conectó
+     */
+    bool conectar(unsigned short puerto, bool udp) {
+        cerrar();
+        datagramas = udp;
+        fd = socket(AF_INET, (udp ? SOCK_DGRAM : SOCK_STREAM) | SOCK_CLOEXEC, 0);
+        if (fd < 0) return false;
+
+        if (!udp) {
+            int uno = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+        }
+
+        sockaddr_in direccion;
+        std::memset(&direccion, 0, sizeof(direccion));
+        direccion.sin_family = AF_INET;
+        direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        direccion.sin_port = htons(puerto);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0) {
+            cerrar();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Cierra el socket
+     */
+    void cerrar() {
+        if (fd >= 0) close(fd);
+        fd = -1;
+        usados = 0;
+    }
+
+    /**
+     * @brief Indica si hay un socket abierto
+     */
+    bool conectado() const {
+        return fd >= 0;
+    }
+
+    /**
+     * @brief Envía bytes completos (bloqueante)
+     * @param datos Bytes a enviar
+     * @param longitud Cantidad de bytes
+     * @return true si se envió todo
+     *
+     * En UDP cada llamada es un datagrama: debe contener tramas completas.
+     */
+    bool enviar(const char* datos, std::size_t longitud) {
+        std::size_t enviados = 0;
+        while (enviados < longitud) {
+            ssize_t n = send(fd, datos + enviados, longitud - enviados, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            enviados += static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Genera y envía tramas
+     * @param generador Fuente de tramas
+     * @param cantidad Tramas a enviar
+     * @return true si se enviaron todas
+     */
+    bool enviarTramas(GeneradorCarga& generador, unsigned long long cantidad) {
+        char buffer[1 << 14];
+        std::size_t capacidad = datagramas ? MAXIMO_DATAGRAMA : sizeof(buffer);
+        while (cantidad > 0) {
+            unsigned long long lote = 0;
+            std::size_t n = generador.generarLote(buffer, capacidad, cantidad, lote);
+            if (lote == 0 || !enviar(buffer, n)) return false;
+            cantidad -= lote;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reproduce las tramas de un archivo (una por línea)
+     * @param ruta Archivo, p. ej. generado con GeneradorCarga::escribirEnArchivo
+     * @param tramas Salida: líneas enviadas
+     * @return true si se leyó y envió todo el archivo
+     */
+    bool reproducirArchivo(const char* ruta, unsigned long long& tramas) {
+        tramas = 0;
+        FILE* archivo = std::fopen(ruta, "r");
+        if (archivo == nullptr) return false;
+
+        char lote[1 << 14];
+        char linea[256];
+        std::size_t capacidad = datagramas ? MAXIMO_DATAGRAMA : sizeof(lote);
+        std::size_t n = 0;
+        bool correcto = true;
+        while (correcto && std::fgets(linea, sizeof(linea), archivo) != nullptr) {
+            std::size_t largo = std::strlen(linea);
+            if (largo == 0 || linea[largo - 1] != '\n') {
+                if (largo + 1 >= sizeof(linea)) continue;  // Línea demasiado larga
+                linea[largo++] = '\n';
+            }
+            if (n + largo > capacidad) {
+                correcto = enviar(lote, n);
+                n = 0;
+            }
+            std::memcpy(lote + n, linea, largo);
+            n += largo;
+            tramas++;
+        }
+        if (correcto && n > 0) correcto = enviar(lote, n);
+        std::fclose(archivo);
+        return correcto;
+    }
+
+    /**
+     * @brief Envía "PING:<dato>"
+     * @param dato Valor que el servidor devuelve en el PONG
+     * @return true si se envió
+     */
+    bool enviarPing(long long dato) {
+        char trama[32] = "PING:";
+        int n = 5 + FormatoTrama::escribirEntero(trama + 5, dato);
+        trama[n++] = '\n';
+        return enviar(trama, static_cast<std::size_t>(n));
+    }
+
+    /**
+     * @brief Espera el próximo "PONG:<dato>" (bloqueante)
+     * @param dato Salida: valor devuelto por el servidor
+     * @return true si llegó un PONG; false si la conexión se cerró
+     */
+    bool esperarPong(long long& dato) {
+        while (true) {
+            char* salto = static_cast<char*>(std::memchr(recibido, '\n', usados));
+            if (salto != nullptr) {
+                *salto = '\0';
+                bool esPong = std::strncmp(recibido, "PONG:", 5) == 0;
+                if (esPong) dato = std::strtoll(recibido + 5, nullptr, 10);
+                std::size_t consumidos = static_cast<std::size_t>(salto - recibido) + 1;
+                std::memmove(recibido, salto + 1, usados - consumidos);
+                usados -= consumidos;
+                if (esPong) return true;
+                continue;
+            }
+            if (usados == sizeof(recibido)) usados = 0;  // Respuesta ilegible
+
+            ssize_t n = recv(fd, recibido + usados, sizeof(recibido) - usados, 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            usados += static_cast<std::size_t>(n);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,598 @@
+/**
+ * @file ExportadorColumnar.h
+ * @brief Exportación de historiales en formato columnar binario (o CSV) y lectura con mmap
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef EXPORTADOR_COLUMNAR_H
+#define EXPORTADOR_COLUMNAR_H
+
+#include "ListaGestion.h"
+#include "ListaSensor.h"
+#include "TiposSensor.h"
+#include "GeneradorCarga.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+/**
+ * @struct CabeceraColumnar
+ * @brief Inicio de un archivo columnar (orden de bytes del equipo que lo escribió)
+ *
+ * Después de la cabecera van, alineadas a 8 bytes:
+ * - inicioIds: uint64[numSensores + 1], posición de cada ID en textoIds
+ * - textoIds: IDs concatenados, sin terminador
+ * - etiquetas: char[4 * numSensores], etiqueta de trama de cada sensor
+ * - sensor: uint32[numLecturas], índice del sensor de cada lectura
+ * - marca: int64[numLecturas], marca de tiempo en ms
+ * - valor: double[numLecturas], lectura
+ *
+ * Las lecturas de un sensor son consecutivas y están en orden de llegada.
+ */
+struct CabeceraColumnar {
+    char magia[8];               ///< "SIOTCOL1"
+    uint32_t version;            ///< Versión del formato
+    uint32_t numSensores;        ///< Sensores exportados
+    uint64_t numLecturas;        ///< Filas de cada columna
+    uint64_t offsetInicioIds;    ///< Posición de inicioIds
+    uint64_t offsetTextoIds;     ///< Posición de textoIds
+    uint64_t offsetEtiquetas;    ///< Posición de etiquetas
+    uint64_t offsetSensor;       ///< Posición de la columna sensor
+    uint64_t offsetMarca;        ///< Posición de la columna marca
+    uint64_t offsetValor;        ///< Posición de la columna valor
+    uint64_t tamanoArchivo;      ///< Bytes totales
+};
+
+/**
+ * @enum FormatoExportacion
+ * @brief Formato del archivo de exportación
+ */
+enum FormatoExportacion {
+    EXPORTAR_COLUMNAR = 0,  ///< Binario columnar (CabeceraColumnar)
+    EXPORTAR_CSV            ///< Texto: id,tipo,marca_ms,valor
+};
+
+/**
+ * @struct ResultadoExportacion
+ * @brief Resumen de una exportación terminada
+ */
+struct ResultadoExportacion {
+    bool exito;                    ///< El archivo quedó completo
+    unsigned long long sensores;   ///< Sensores exportados
+    unsigned long long lecturas;   ///< Lecturas exportadas
+    unsigned long long bytes;      ///< Tamaño del archivo
+    double segundos;               ///< Duración de la escritura
+
+    ResultadoExportacion() : exito(false), sensores(0), lecturas(0), bytes(0), segundos(0.0) {}
+};
+
+/**
+ * @struct LeerHistorial
+ * @brief Copia un tramo de la foto de un historial de tipo Traits a columnas
+ */
+template <typename Traits>
+struct LeerHistorial {
+    /**
+     * @param cursor Nodo actual (Nodo<Traits::Valor>*); avanza lo leído
+     * @param restantes Lecturas de la foto aún sin leer
+     * @param marcas Salida: marcas
+     * @param valores Salida: valores
+     * @param capacidad Máximo de lecturas a copiar
+     * @return Lecturas copiadas
+     *
+     * Nunca lee el siguiente del último nodo de la foto, que la ingesta
+     * puede estar escribiendo.
+     */
+    static int ejecutar(const void*& cursor, int restantes, int64_t* marcas, double* valores,
+                        int capacidad) {
+        const Nodo<typename Traits::Valor>* nodo =
+            static_cast<const Nodo<typename Traits::Valor>*>(cursor);
+        int n = restantes < capacidad ? restantes : capacidad;
+        for (int i = 0; i < n; i++) {
+            marcas[i] = nodo->marca;
+            valores[i] = static_cast<double>(nodo->dato);
+            if (i + 1 < restantes) nodo = nodo->siguiente;
+        }
+        cursor = nodo;
+        return n;
+    }
+};
+
+/**
+ * @brief Escribe una lectura en texto: enteros exactos, float con 7 cifras
+ */
+inline int formatearLecturaCsv(char* destino, int valor) {
+    return FormatoTrama::escribirEntero(destino, valor);
+}
+
+/**
+ * @brief Escribe una lectura en texto: enteros exactos, float con 7 cifras
+ */
+inline int formatearLecturaCsv(char* destino, float valor) {
+    return std::snprintf(destino, 24, "%.7g", static_cast<double>(valor));
+}
+
+/**
+ * @class BloqueArchivo
+ * @brief Buffer grande que se vuelca a un descriptor con write()
+ */
+class BloqueArchivo {
+private:
+    int fd;                   ///< Descriptor destino
+    std::vector<char> datos;  ///< Buffer
+    std::size_t usados;       ///< Bytes pendientes
+    bool correcto;            ///< No hubo errores de escritura
+    unsigned long long total; ///< Bytes escritos
+
+public:
+    /**
+     * @param descriptor Descriptor abierto para escritura
+     * @param capacidad Tamaño del buffer
+     */
+    BloqueArchivo(int descriptor, std::size_t capacidad)
+        : fd(descriptor), datos(capacidad), usados(0), correcto(true), total(0) {}
+
+    /**
+     * @brief Vuelca el buffer
+     */
+    void vaciar() {
+        std::size_t escritos = 0;
+        while (correcto && escritos < usados) {
+            ssize_t n = ::write(fd, &datos[escritos], usados - escritos);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) correcto = false;
+            else escritos += static_cast<std::size_t>(n);
+        }
+        total += escritos;
+        usados = 0;
+    }
+
+    /**
+     * @brief Garantiza espacio contiguo y devuelve dónde escribir
+     * @param n Bytes que se van a escribir (como máximo)
+     */
+    char* reservar(std::size_t n) {
+        if (usados + n > datos.size()) vaciar();
+        return &datos[usados];
+    }
+
+    /**
+     * @brief Confirma bytes escritos en lo devuelto por reservar()
+     */
+    void avanzar(std::size_t n) {
+        usados += n;
+    }
+
+    bool getCorrecto() const { return correcto; }          ///< Sin errores de escritura
+    unsigned long long getTotal() const { return total; }  ///< Bytes escritos
+};
+
+/**
+ * @struct EscribirHistorialCsv
+ * @brief Escribe la foto de un historial de tipo Traits como filas CSV
+ */
+template <typename Traits>
+struct EscribirHistorialCsv {
+    /**
+     * @param foto Historial fotografiado
+     * @param archivo Destino
+     */
+    static void ejecutar(const InstantaneaSensor& foto, BloqueArchivo& archivo) {
+        const Nodo<typename Traits::Valor>* nodo =
+            static_cast<const Nodo<typename Traits::Valor>*>(foto.historial);
+        for (int i = 0; i < foto.cantidad; i++) {
+            char* p = archivo.reservar(foto.id.size() + 64);
+            std::size_t n = foto.id.size();
+            std::memcpy(p, foto.id.data(), n);
+            p[n++] = ',';
+            for (int b = 0; b < 4; b++) {
+                p[n++] = static_cast<char>((Traits::codigo >> (8 * b)) & 0xFF);
+            }
+            p[n++] = ',';
+            n += FormatoTrama::escribirEntero(p + n, nodo->marca);
+            p[n++] = ',';
+            n += formatearLecturaCsv(p + n, nodo->dato);
+            p[n++] = '\n';
+            archivo.avanzar(n);
+            if (i + 1 < foto.cantidad) nodo = nodo->siguiente;
+        }
+    }
+};
+
+/**
+ * @class ExportadorColumnar
+ * @brief Exporta los historiales de una foto de ListaGestion en un hilo aparte
+ *
+ * La foto se toma en iniciar(), en el hilo dueño de la lista; la
+ * escritura corre en segundo plano y puede convivir con la ingesta,
+ * que solo agrega nodos después de los fotografiados. Cada columna se
+ * acumula en bloques de LECTURAS_POR_BLOQUE y se escribe con pwrite en
+ * su región del archivo; el archivo se escribe con otro nombre y se
+ * renombra al final, así que nunca se lee a medias.
+ */
+class ExportadorColumnar {
+public:
+    static const int LECTURAS_POR_BLOQUE = 1 << 16;  ///< Filas por escritura de columna
+
+private:
+    typedef int (*FuncionLeerHistorial)(const void*&, int, int64_t*, double*, int);
+    typedef void (*FuncionEscribirCsv)(const InstantaneaSensor&, BloqueArchivo&);
+
+    ListaGestion* lista;                      ///< Lista fotografiada (para liberar la foto)
+    std::vector<InstantaneaSensor> foto;      ///< Foto en exportación
+    std::string ruta;                         ///< Archivo destino
+    FormatoExportacion formato;               ///< Formato pedido
+    std::thread hilo;                         ///< Hilo de escritura
+    std::atomic<bool> enCurso;                ///< Hay una exportación sin terminar
+    ResultadoExportacion resultado;           ///< Resultado de la última exportación
+
+    ExportadorColumnar(const ExportadorColumnar&);
+    ExportadorColumnar& operator=(const ExportadorColumnar&);
+
+    /**
+     * @brief Redondea hacia arriba a múltiplo de 8
+     */
+    static uint64_t alinear(uint64_t posicion) {
+        return (posicion + 7) & ~static_cast<uint64_t>(7);
+    }
+
+    /**
+     * @brief pwrite completo
+     * @return true si se escribió todo
+     */
+    static bool escribirEn(int fd, const void* datos, std::size_t n, uint64_t posicion) {
+        const char* p = static_cast<const char*>(datos);
+        while (n > 0) {
+            ssize_t escritos = ::pwrite(fd, p, n, static_cast<off_t>(posicion));
+            if (escritos < 0 && errno == EINTR) continue;
+            if (escritos <= 0) return false;
+            p += escritos;
+            n -= static_cast<std::size_t>(escritos);
+            posicion += static_cast<uint64_t>(escritos);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Escribe la foto en formato columnar
+     * @param fd Archivo destino (vacío)
+     * @param foto Historiales
+     * @param resultado Salida: lecturas y bytes
+     * @return true si se escribió todo
+     */
+    static bool escribirColumnar(int fd, const std::vector<InstantaneaSensor>& foto,
+                                 ResultadoExportacion& resultado) {
+        static const TablaPorTipo<LeerHistorial, FuncionLeerHistorial> lectores;
+
+        CabeceraColumnar cabecera;
+        std::memset(&cabecera, 0, sizeof(cabecera));
+        std::memcpy(cabecera.magia, "SIOTCOL1", 8);
+        cabecera.version = 1;
+        cabecera.numSensores = static_cast<uint32_t>(foto.size());
+
+        // Diccionario de sensores
+        std::vector<uint64_t> inicioIds(foto.size() + 1, 0);
+        std::string textoIds;
+        std::vector<char> etiquetas(4 * foto.size());
+        for (std::size_t s = 0; s < foto.size(); s++) {
+            inicioIds[s] = textoIds.size();
+            textoIds += foto[s].id;
+            for (int b = 0; b < 4; b++) {
+                etiquetas[4 * s + b] = static_cast<char>((foto[s].codigo >> (8 * b)) & 0xFF);
+            }
+            cabecera.numLecturas += static_cast<uint64_t>(foto[s].cantidad);
+        }
+        inicioIds[foto.size()] = textoIds.size();
+
+        const uint64_t n = cabecera.numLecturas;
+        cabecera.offsetInicioIds = alinear(sizeof(CabeceraColumnar));
+        cabecera.offsetTextoIds = cabecera.offsetInicioIds + inicioIds.size() * sizeof(uint64_t);
+        cabecera.offsetEtiquetas = cabecera.offsetTextoIds + textoIds.size();
+        cabecera.offsetSensor = alinear(cabecera.offsetEtiquetas + etiquetas.size());
+        cabecera.offsetMarca = alinear(cabecera.offsetSensor + n * sizeof(uint32_t));
+        cabecera.offsetValor = cabecera.offsetMarca + n * sizeof(int64_t);
+        cabecera.tamanoArchivo = cabecera.offsetValor + n * sizeof(double);
+
+        bool correcto = ::ftruncate(fd, static_cast<off_t>(cabecera.tamanoArchivo)) == 0
+            && escribirEn(fd, &cabecera, sizeof(cabecera), 0)
+            && escribirEn(fd, &inicioIds[0], inicioIds.size() * sizeof(uint64_t), cabecera.offsetInicioIds)
+            && escribirEn(fd, textoIds.data(), textoIds.size(), cabecera.offsetTextoIds)
+            && (etiquetas.empty() || escribirEn(fd, &etiquetas[0], etiquetas.size(), cabecera.offsetEtiquetas));
+
+        // Columnas: se llenan en bloques y cada bloque va a su región
+        std::vector<uint32_t> sensores(LECTURAS_POR_BLOQUE);
+        std::vector<int64_t> marcas(LECTURAS_POR_BLOQUE);
+        std::vector<double> valores(LECTURAS_POR_BLOQUE);
+        uint64_t escritas = 0;
+        int usados = 0;
+
+        for (std::size_t s = 0; correcto && s <= foto.size(); s++) {
+            const void* cursor = s < foto.size() ? foto[s].historial : nullptr;
+            int restantes = s < foto.size() ? foto[s].cantidad : 0;
+            FuncionLeerHistorial leer = s < foto.size() ? lectores[foto[s].tipo] : nullptr;
+            bool ultimo = s == foto.size();
+
+            while (correcto && (restantes > 0 || (ultimo && usados > 0))) {
+                if (restantes > 0) {
+                    int copiadas = leer(cursor, restantes, &marcas[usados], &valores[usados],
+                                        LECTURAS_POR_BLOQUE - usados);
+                    std::fill(sensores.begin() + usados, sensores.begin() + usados + copiadas,
+                              static_cast<uint32_t>(s));
+                    usados += copiadas;
+                    restantes -= copiadas;
+                }
+                if (usados == LECTURAS_POR_BLOQUE || (ultimo && usados > 0)) {
+                    correcto = escribirEn(fd, &sensores[0], usados * sizeof(uint32_t),
+                                          cabecera.offsetSensor + escritas * sizeof(uint32_t))
+                        && escribirEn(fd, &marcas[0], usados * sizeof(int64_t),
+                                      cabecera.offsetMarca + escritas * sizeof(int64_t))
+                        && escribirEn(fd, &valores[0], usados * sizeof(double),
+                                      cabecera.offsetValor + escritas * sizeof(double));
+                    escritas += static_cast<uint64_t>(usados);
+                    usados = 0;
+                }
+            }
+        }
+
+        resultado.lecturas = escritas;
+        resultado.bytes = cabecera.tamanoArchivo;
+        return correcto && escritas == n;
+    }
+
+    /**
+     * @brief Escribe la foto como CSV (id,tipo,marca_ms,valor)
+     * @param fd Archivo destino (vacío)
+     * @param foto Historiales
+     * @param resultado Salida: lecturas y bytes
+     * @return true si se escribió todo
+     */
+    static bool escribirCsv(int fd, const std::vector<InstantaneaSensor>& foto,
+                            ResultadoExportacion& resultado) {
+        static const TablaPorTipo<EscribirHistorialCsv, FuncionEscribirCsv> escritores;
+
+        BloqueArchivo archivo(fd, 1 << 20);
+        static const char encabezado[] = "id,tipo,marca_ms,valor\n";
+        std::memcpy(archivo.reservar(sizeof(encabezado)), encabezado, sizeof(encabezado) - 1);
+        archivo.avanzar(sizeof(encabezado) - 1);
+
+        for (std::size_t s = 0; s < foto.size() && archivo.getCorrecto(); s++) {
+            escritores[foto[s].tipo](foto[s], archivo);
+            resultado.lecturas += static_cast<unsigned long long>(foto[s].cantidad);
+        }
+        archivo.vaciar();
+        resultado.bytes = archivo.getTotal();
+        return archivo.getCorrecto();
+    }
+
+    /**
+     * @brief Cuerpo del hilo de escritura
+     */
+    void escribir() {
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        resultado = ResultadoExportacion();
+        resultado.sensores = foto.size();
+
+        std::string temporal = ruta + ".tmp";
+        int fd = ::open(temporal.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        bool correcto = fd >= 0;
+        if (correcto) {
+            correcto = formato == EXPORTAR_CSV ? escribirCsv(fd, foto, resultado)
+                                               : escribirColumnar(fd, foto, resultado);
+            correcto = ::close(fd) == 0 && correcto;
+        }
+        lista->liberarInstantanea();
+        foto.clear();
+
+        if (correcto) {
+            correcto = std::rename(temporal.c_str(), ruta.c_str()) == 0;
+        } else if (fd >= 0) {
+            std::remove(temporal.c_str());
+        }
+        resultado.exito = correcto;
+        resultado.segundos = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - inicio).count();
+        enCurso.store(false);
+    }
+
+public:
+    /**
+     * @brief Constructor
+     */
+    ExportadorColumnar() : lista(nullptr), formato(EXPORTAR_COLUMNAR), enCurso(false) {}
+
+    /**
+     * @brief Espera la exportación en curso
+     */
+    ~ExportadorColumnar() {
+        esperar();
+    }
+
+    /**
+     * @brief Toma la foto y comienza a escribir en segundo plano
+     * @param l Lista a exportar (se llama desde el hilo que la modifica)
+     * @param destino Archivo destino
+     * @param f Formato
+     * @return Lecturas incluidas en la foto, o -1 si ya hay una exportación en curso
+     */
+    long long iniciar(ListaGestion& l, const std::string& destino, FormatoExportacion f) {
+        if (enCurso.load()) return -1;
+        esperar();
+
+        lista = &l;
+        ruta = destino;
+        formato = f;
+        lista->tomarInstantanea(foto);
+        long long lecturas = 0;
+        for (std::size_t s = 0; s < foto.size(); s++) {
+            lecturas += foto[s].cantidad;
+        }
+
+        enCurso.store(true);
+        hilo = std::thread(&ExportadorColumnar::escribir, this);
+        return lecturas;
+    }
+
+    /**
+     * @brief Indica si hay una exportación sin terminar
+     */
+    bool activo() const {
+        return enCurso.load();
+    }
+
+    /**
+     * @brief Espera a que termine la exportación en curso
+     * @return Resultado de la última exportación
+     */
+    const ResultadoExportacion& esperar() {
+        if (hilo.joinable()) hilo.join();
+        return resultado;
+    }
+};
+
+/**
+ * @class LectorColumnar
+ * @brief Acceso sin copias a un archivo columnar mediante mmap
+ *
+ * Las columnas se devuelven como punteros dentro del archivo mapeado;
+ * siguen siendo válidos hasta cerrar() o destruir el lector.
+ */
+class LectorColumnar {
+private:
+    const char* base;                  ///< Inicio del mapeo
+    std::size_t tamano;                ///< Bytes mapeados
+    const CabeceraColumnar* cabecera;  ///< Cabecera (dentro del mapeo)
+
+    LectorColumnar(const LectorColumnar&);
+    LectorColumnar& operator=(const LectorColumnar&);
+
+    /**
+     * @brief Verifica que la cabecera describa un archivo de este tamaño
+     */
+    bool validar() const {
+        const CabeceraColumnar& c = *cabecera;
+        uint64_t n = c.numLecturas;
+        uint64_t s = c.numSensores;
+        if (std::memcmp(c.magia, "SIOTCOL1", 8) != 0 || c.version != 1) return false;
+        if (c.tamanoArchivo != tamano) return false;
+        if (c.offsetInicioIds % 8 != 0 || c.offsetSensor % 4 != 0
+            || c.offsetMarca % 8 != 0 || c.offsetValor % 8 != 0) return false;
+        if (c.offsetInicioIds + (s + 1) * sizeof(uint64_t) > c.offsetTextoIds) return false;
+        if (c.offsetEtiquetas + 4 * s > c.offsetSensor) return false;
+        if (c.offsetSensor + n * sizeof(uint32_t) > c.offsetMarca) return false;
+        if (c.offsetMarca + n * sizeof(int64_t) > c.offsetValor) return false;
+        if (c.offsetValor + n * sizeof(double) > tamano) return false;
+        const uint64_t* inicio = reinterpret_cast<const uint64_t*>(base + c.offsetInicioIds);
+        return inicio[s] <= c.offsetEtiquetas - c.offsetTextoIds;
+    }
+
+public:
+    /**
+     * @brief Constructor (sin archivo)
+     */
+    LectorColumnar() : base(nullptr), tamano(0), cabecera(nullptr) {}
+
+    /**
+     * @brief Destructor: desmapea el archivo
+     */
+    ~LectorColumnar() {
+        cerrar();
+    }
+
+    /**
+     * @brief Mapea un archivo y valida su cabecera
+     * @param ruta Archivo escrito por ExportadorColumnar
+     * @return true si el archivo es válido
+     */
+    bool abrir(const char* ruta) {
+        cerrar();
+        int fd = ::open(ruta, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(CabeceraColumnar)) {
+            ::close(fd);
+            return false;
+        }
+        tamano = static_cast<std::size_t>(info.st_size);
+        void* mapeo = ::mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapeo == MAP_FAILED) {
+            tamano = 0;
+            return false;
+        }
+        base = static_cast<const char*>(mapeo);
+        cabecera = reinterpret_cast<const CabeceraColumnar*>(base);
+        if (!validar()) {
+            cerrar();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Desmapea el archivo
+     */
+    void cerrar() {
+        if (base != nullptr) ::munmap(const_cast<char*>(base), tamano);
+        base = nullptr;
+        cabecera = nullptr;
+        tamano = 0;
+    }
+
+    uint32_t getNumSensores() const { return cabecera->numSensores; }  ///< Sensores en el archivo
+    uint64_t getNumLecturas() const { return cabecera->numLecturas; }  ///< Filas de cada columna
+
+    /**
+     * @brief Columna sensor: índice del sensor de cada lectura
+     */
+    const uint32_t* columnaSensor() const {
+        return reinterpret_cast<const uint32_t*>(base + cabecera->offsetSensor);
+    }
+
+    /**
+     * @brief Columna marca: marca de tiempo en ms de cada lectura
+     */
+    const int64_t* columnaMarca() const {
+        return reinterpret_cast<const int64_t*>(base + cabecera->offsetMarca);
+    }
+
+    /**
+     * @brief Columna valor: cada lectura como double
+     */
+    const double* columnaValor() const {
+        return reinterpret_cast<const double*>(base + cabecera->offsetValor);
+    }
+
+    /**
+     * @brief ID de un sensor
+     * @param i Índice del sensor
+     */
+    std::string id(uint32_t i) const {
+        const uint64_t* inicio = reinterpret_cast<const uint64_t*>(base + cabecera->offsetInicioIds);
+        const char* texto = base + cabecera->offsetTextoIds;
+        return std::string(texto + inicio[i], texto + inicio[i + 1]);
+    }
+
+    /**
+     * @brief Etiqueta de trama de un sensor ("TEMP", "PRES", ...)
+     * @param i Índice del sensor
+     */
+    std::string etiqueta(uint32_t i) const {
+        return std::string(base + cabecera->offsetEtiquetas + 4 * i, 4);
+    }
+};
+
+#endif
@@ -0,0 +1,90 @@
+/**
+ * @file FiltroDuplicados.h
+ * @brief Huellas de las últimas lecturas de un sensor para descartar retransmisiones
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef FILTRO_DUPLICADOS_H
+#define FILTRO_DUPLICADOS_H
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @class FiltroDuplicados
+ * @brief Anillo fijo con las huellas de las últimas lecturas con marca
+ *
+ * Un reintento serie o una pasarela que se reconecta reenvía la misma
+ * trama con la misma marca: su huella (marca y valor ya convertido, así
+ * que "21.5" y "21.50" coinciden) ya está en el anillo. El costo es un
+ * hash corto y la comparación con HUELLAS enteros contiguos; la memoria
+ * por sensor es fija. Solo se recuerdan las últimas HUELLAS lecturas,
+ * suficiente para reintentos, que llegan juntos (y más aún después de
+ * ReordenadorLecturas).
+ *
+ * Las lecturas sin marca quedan fuera: una retransmisión sin marca no
+ * se distingue de una lectura nueva con el mismo valor.
+ */
+class FiltroDuplicados {
+public:
+    static const int HUELLAS = 16;  ///< Lecturas recordadas
+
+private:
+    unsigned long long huellas[HUELLAS];  ///< Huellas recientes (0 = vacía)
+    int siguiente;                        ///< Posición a reemplazar
+
+public:
+    /**
+     * @brief Constructor (anillo vacío)
+     */
+    FiltroDuplicados() : siguiente(0) {
+        for (int i = 0; i < HUELLAS; i++) {
+            huellas[i] = 0;
+        }
+    }
+
+    /**
+     * @brief Huella de una lectura (FNV-1a de los bytes del valor mezclado con la marca)
+     * @param marca Marca de tiempo de la lectura
+     * @param valor Lectura ya convertida a la unidad del tipo
+     * @return Huella distinta de 0
+     */
+    static unsigned long long huella(long long marca, double valor) {
+        if (valor == 0.0) valor = 0.0;  // -0.0 y 0.0 son la misma lectura
+        unsigned long long bits;
+        std::memcpy(&bits, &valor, sizeof(bits));
+
+        unsigned long long h = 14695981039346656037ULL ^ static_cast<unsigned long long>(marca);
+        for (std::size_t i = 0; i < sizeof(bits); i++) {
+            h ^= (bits >> (8 * i)) & 0xFF;
+            h *= 1099511628211ULL;
+        }
+        h ^= h >> 29;
+        return h != 0 ? h : 1;
+    }
+
+    /**
+     * @brief Indica si una huella está entre las recientes
+     * @param h Huella de la lectura
+     * @return true si es una lectura duplicada
+     */
+    bool contiene(unsigned long long h) const {
+        bool repetida = false;
+        for (int i = 0; i < HUELLAS; i++) {
+            repetida |= huellas[i] == h;
+        }
+        return repetida;
+    }
+
+    /**
+     * @brief Recuerda una huella (llamar solo con lecturas aceptadas)
+     * @param h Huella de la lectura
+     */
+    void registrar(unsigned long long h) {
+        huellas[siguiente] = h;
+        siguiente = (siguiente + 1) & (HUELLAS - 1);
+    }
+};
+
+#endif
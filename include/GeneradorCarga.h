@@ -0,0 +1,424 @@
+/**
+ * @file GeneradorCarga.h
+ * @brief Generador determinista de tramas "TIPO:ID:VALOR" a alta tasa
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef GENERADOR_CARGA_H
+#define GENERADOR_CARGA_H
+
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+
+/**
+ * @class GeneradorAleatorio
+ * @brief PRNG xorshift64* con semilla explícita
+ *
+ * Cada instancia tiene su propio estado: misma semilla, misma secuencia,
+ * sin depender de srand()/rand() globales.
+ */
+class GeneradorAleatorio {
+private:
+    unsigned long long estado;  ///< Estado interno (nunca cero)
+
+public:
+    /**
+     * @brief Constructor
+     * @param semilla Semilla (se dispersa con splitmix64)
+     */
+    explicit GeneradorAleatorio(unsigned long long semilla = 1) {
+        sembrar(semilla);
+    }
+
+    /**
+     * @brief Reinicia la secuencia
+     * @param semilla Nueva semilla
+     */
+    void sembrar(unsigned long long semilla) {
+        unsigned long long z = semilla + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        estado = z ^ (z >> 31);
+        if (estado == 0) estado = 0x9E3779B97F4A7C15ULL;
+    }
+
+    /**
+     * @brief Siguiente número de 64 bits
+     */
+    unsigned long long siguiente() {
+        estado ^= estado >> 12;
+        estado ^= estado << 25;
+        estado ^= estado >> 27;
+        return estado * 0x2545F4914F6CDD1DULL;
+    }
+
+    /**
+     * @brief Entero uniforme en [0, n)
+     * @param n Límite superior (exclusivo)
+     */
+    unsigned int entero(unsigned int n) {
+        return static_cast<unsigned int>(((siguiente() >> 32) * n) >> 32);
+    }
+
+    /**
+     * @brief Real uniforme en [0, 1)
+     */
+    double uniforme() {
+        return (siguiente() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @brief Aproximación normal estándar (Irwin-Hall con 4 uniformes)
+     *
+     * Usa los cuatro bloques de 16 bits de un solo número, por lo que
+     * cuesta una llamada al PRNG y ninguna función trascendente.
+     */
+    double normal() {
+        unsigned long long r = siguiente();
+        double suma = static_cast<double>(r & 0xFFFF) + static_cast<double>((r >> 16) & 0xFFFF)
+                    + static_cast<double>((r >> 32) & 0xFFFF) + static_cast<double>(r >> 48);
+        // Media 2, varianza 1/3 -> normalizar a media 0, varianza 1
+        return (suma / 65536.0 - 2.0) * 1.7320508075688772;
+    }
+};
+
+/**
+ * @namespace FormatoTrama
+ * @brief Escritura de números sin snprintf
+ */
+namespace FormatoTrama {
+    /**
+     * @brief Escribe un entero en decimal
+     * @param destino Buffer (debe tener al menos 21 bytes libres)
+     * @param valor Valor a escribir
+     * @return Número de caracteres escritos
+     */
+    inline int escribirEntero(char* destino, long long valor) {
+        char temp[24];
+        int n = 0;
+        unsigned long long v = valor < 0 ? 0ULL - static_cast<unsigned long long>(valor)
+                                         : static_cast<unsigned long long>(valor);
+        do {
+            temp[n++] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        } while (v != 0);
+
+        int escritos = 0;
+        if (valor < 0) destino[escritos++] = '-';
+        while (n > 0) destino[escritos++] = temp[--n];
+        return escritos;
+    }
+
+    /**
+     * @brief Escribe un real con un decimal (equivale a "%.1f")
+     * @param destino Buffer (debe tener al menos 23 bytes libres)
+     * @param valor Valor a escribir
+     * @return Número de caracteres escritos
+     */
+    inline int escribirDecimal(char* destino, double valor) {
+        long long decimas = static_cast<long long>(valor * 10.0 + (valor < 0 ? -0.5 : 0.5));
+        int escritos = 0;
+        if (decimas < 0) {
+            destino[escritos++] = '-';
+            decimas = -decimas;
+        }
+        escritos += escribirEntero(destino + escritos, decimas / 10);
+        destino[escritos++] = '.';
+        destino[escritos++] = static_cast<char>('0' + decimas % 10);
+        return escritos;
+    }
+}
+
+/**
+ * @struct ConfiguracionCarga
+ * @brief Parámetros de la flota simulada y de sus distribuciones
+ *
+ * Las magnitudes de deriva, ruido y picos se expresan en "escalas"
+ * del tipo: 1 C para temperatura, 5 hPa para presión y 5 unidades
+ * para vibración.
+ */
+struct ConfiguracionCarga {
+    unsigned long long semilla;      ///< Semilla del PRNG
+    int sensoresTemperatura;         ///< Sensores TEMP en la flota
+    int sensoresPresion;             ///< Sensores PRES en la flota
+    int sensoresVibracion;           ///< Sensores VIBR en la flota
+    double deriva;                   ///< Desviación del paso de caminata aleatoria
+    double ruido;                    ///< Desviación del ruido por lectura
+    double probabilidadPico;         ///< Probabilidad de pico por lectura
+    double magnitudPico;             ///< Tamaño del pico
+    double probabilidadRafaga;       ///< Probabilidad de iniciar una ráfaga
+    int longitudRafaga;              ///< Tramas consecutivas del mismo sensor en ráfaga
+
+    /**
+     * @brief Constructor con valores típicos
+     */
+    ConfiguracionCarga()
+        : semilla(1), sensoresTemperatura(1), sensoresPresion(1), sensoresVibracion(1),
+          deriva(0.05), ruido(0.5), probabilidadPico(0.001), magnitudPico(10.0),
+          probabilidadRafaga(0.01), longitudRafaga(8) {}
+};
+
+/**
+ * @class GeneradorCarga
+ * @brief Emite tramas de una flota configurable de sensores
+ *
+ * Cada sensor tiene un valor base, una deriva (caminata aleatoria que
+ * tiende a cero), ruido gaussiano y picos ocasionales. Las llegadas
+ * pueden agruparse en ráfagas del mismo sensor. Los identificadores
+ * se preformatean una sola vez, así que generar una trama solo copia
+ * bytes y escribe el número.
+ */
+class GeneradorCarga {
+private:
+    /**
+     * @brief Tipo de sensor simulado
+     */
+    enum Tipo { TEMPERATURA = 0, PRESION = 1, VIBRACION = 2 };
+
+    /**
+     * @struct SensorSimulado
+     * @brief Estado de un sensor de la flota
+     */
+    struct SensorSimulado {
+        char prefijo[24];   ///< "TIPO:ID:" preformateado
+        int longitud;       ///< Longitud del prefijo
+        Tipo tipo;          ///< Tipo de sensor
+        double base;        ///< Valor central
+        double desvio;      ///< Deriva acumulada
+    };
+
+    ConfiguracionCarga config;              ///< Parámetros
+    GeneradorAleatorio aleatorio;           ///< PRNG propio
+    std::vector<SensorSimulado> sensores;   ///< Flota
+    int sensorRafaga;                       ///< Sensor de la ráfaga en curso
+    int restantesRafaga;                    ///< Tramas restantes de la ráfaga
+    unsigned long long generadas;           ///< Tramas emitidas
+
+    /**
+     * @brief Agrega los sensores de un tipo a la flota
+     */
+    void crearSensores(Tipo tipo, int cantidad, const char* etiqueta, char letra,
+                       double minimo, double maximo) {
+        for (int i = 1; i <= cantidad; i++) {
+            SensorSimulado s;
+            char id[16];
+            // Con un solo sensor se conservan los IDs del sketch Arduino
+            if (cantidad == 1) {
+                static const char* clasicos[3] = { "T-001", "P-105", "V-201" };
+                strcpy(id, clasicos[tipo]);
+            } else {
+                id[0] = letra;
+                id[1] = '-';
+                int n = FormatoTrama::escribirEntero(id + 2, i);
+                id[2 + n] = '\0';
+            }
+            memcpy(s.prefijo, etiqueta, 4);
+            s.prefijo[4] = ':';
+            s.longitud = 5;
+            size_t largoId = strlen(id);
+            memcpy(s.prefijo + s.longitud, id, largoId);
+            s.longitud += static_cast<int>(largoId);
+            s.prefijo[s.longitud++] = ':';
+            s.tipo = tipo;
+            s.base = minimo + aleatorio.uniforme() * (maximo - minimo);
+            s.desvio = 0.0;
+            sensores.push_back(s);
+        }
+    }
+
+    /**
+     * @brief Escala de magnitudes por tipo
+     */
+    static double escala(Tipo tipo) {
+        return tipo == TEMPERATURA ? 1.0 : 5.0;
+    }
+
+    /**
+     * @brief Elige el siguiente sensor respetando ráfagas
+     */
+    int elegirSensor() {
+        if (restantesRafaga > 0) {
+            restantesRafaga--;
+            return sensorRafaga;
+        }
+        int indice = static_cast<int>(aleatorio.entero(static_cast<unsigned int>(sensores.size())));
+        if (config.longitudRafaga > 1 && aleatorio.uniforme() < config.probabilidadRafaga) {
+            sensorRafaga = indice;
+            restantesRafaga = config.longitudRafaga - 1;
+        }
+        return indice;
+    }
+
+public:
+    static const int LONGITUD_MAXIMA_TRAMA = 48;        ///< Cota de bytes por trama (sin '\n')
+    static const int MAXIMO_SENSORES_POR_TIPO = 1000000; ///< Cota de sensores simulados de cada tipo
+
+    /**
+     * @brief Acota una cantidad de sensores a [0, MAXIMO_SENSORES_POR_TIPO]
+     * @param cantidad Cantidad pedida
+     * @return Cantidad utilizable
+     */
+    static int acotarSensores(int cantidad) {
+        if (cantidad < 0) return 0;
+        if (cantidad > MAXIMO_SENSORES_POR_TIPO) return MAXIMO_SENSORES_POR_TIPO;
+        return cantidad;
+    }
+
+    /**
+     * @brief Constructor
+     * @param c Configuración de la flota (las cantidades fuera de rango se acotan)
+     */
+    explicit GeneradorCarga(const ConfiguracionCarga& c)
+        : config(c), aleatorio(c.semilla), sensorRafaga(0), restantesRafaga(0), generadas(0) {
+        config.sensoresTemperatura = acotarSensores(c.sensoresTemperatura);
+        config.sensoresPresion = acotarSensores(c.sensoresPresion);
+        config.sensoresVibracion = acotarSensores(c.sensoresVibracion);
+        sensores.reserve(static_cast<size_t>(config.sensoresTemperatura + config.sensoresPresion
+                                             + config.sensoresVibracion));
+        crearSensores(TEMPERATURA, config.sensoresTemperatura, "TEMP", 'T', 20.0, 30.0);
+        crearSensores(PRESION, config.sensoresPresion, "PRES", 'P', 1000.0, 1050.0);
+        crearSensores(VIBRACION, config.sensoresVibracion, "VIBR", 'V', 10.0, 50.0);
+    }
+
+    /**
+     * @brief Número de sensores de la flota
+     */
+    int getCantidadSensores() const {
+        return static_cast<int>(sensores.size());
+    }
+
+    /**
+     * @brief Tramas generadas hasta ahora
+     */
+    unsigned long long getGeneradas() const {
+        return generadas;
+    }
+
+    /**
+     * @brief Escribe una trama (sin terminador)
+     * @param destino Buffer con al menos LONGITUD_MAXIMA_TRAMA bytes
+     * @return Longitud escrita (0 si la flota está vacía)
+     */
+    int generarTrama(char* destino) {
+        if (sensores.empty()) return 0;
+
+        SensorSimulado& s = sensores[static_cast<size_t>(elegirSensor())];
+        double k = escala(s.tipo);
+
+        s.desvio = s.desvio * 0.999 + aleatorio.normal() * config.deriva * k;
+        double valor = s.base + s.desvio + aleatorio.normal() * config.ruido * k;
+        if (aleatorio.uniforme() < config.probabilidadPico) {
+            valor += (s.tipo == PRESION ? -config.magnitudPico : config.magnitudPico) * k;
+        }
+
+        memcpy(destino, s.prefijo, static_cast<size_t>(s.longitud));
+        int n = s.longitud;
+        if (s.tipo == TEMPERATURA) {
+            n += FormatoTrama::escribirDecimal(destino + n, valor);
+        } else {
+            long long entero = static_cast<long long>(valor + (valor < 0 ? -0.5 : 0.5));
+            if (s.tipo == VIBRACION && entero < 0) entero = 0;
+            n += FormatoTrama::escribirEntero(destino + n, entero);
+        }
+        generadas++;
+        return n;
+    }
+
+    /**
+     * @brief Llena un buffer con tramas separadas por '\n'
+     * @param buffer Destino
+     * @param tam Capacidad del buffer
+     * @param maxTramas Máximo de tramas a escribir
+     * @param tramas Salida: tramas escritas
+     * @return Bytes escritos
+     */
+    size_t generarLote(char* buffer, size_t tam, unsigned long long maxTramas,
+                       unsigned long long& tramas) {
+        size_t usado = 0;
+        tramas = 0;
+        while (tramas < maxTramas && usado + LONGITUD_MAXIMA_TRAMA + 1 <= tam) {
+            int n = generarTrama(buffer + usado);
+            if (n == 0) break;
+            usado += static_cast<size_t>(n);
+            buffer[usado++] = '\n';
+            tramas++;
+        }
+        return usado;
+    }
+
+    /**
+     * @brief Escribe tramas en un descriptor (archivo, pipe o pty)
+     * @param fd Descriptor abierto para escritura
+     * @param numTramas Tramas a emitir
+     * @return Tramas escritas (menor si ocurrió un error)
+     */
+    unsigned long long escribirEnDescriptor(int fd, unsigned long long numTramas) {
+        static const size_t TAM_BLOQUE = 1 << 16;
+        std::vector<char> bloque(TAM_BLOQUE);
+        unsigned long long escritas = 0;
+
+        while (escritas < numTramas) {
+            unsigned long long tramas = 0;
+            size_t bytes = generarLote(&bloque[0], TAM_BLOQUE, numTramas - escritas, tramas);
+            if (bytes == 0) break;
+
+            size_t enviado = 0;
+            while (enviado < bytes) {
+                ssize_t r = ::write(fd, &bloque[enviado], bytes - enviado);
+                if (r < 0) {
+                    if (errno == EINTR) continue;
+                    return escritas;
+                }
+                enviado += static_cast<size_t>(r);
+            }
+            escritas += tramas;
+        }
+        return escritas;
+    }
+
+    /**
+     * @brief Escribe tramas en un archivo (lo crea o trunca)
+     * @param ruta Archivo destino
+     * @param numTramas Tramas a emitir
+     * @return Tramas escritas
+     */
+    unsigned long long escribirEnArchivo(const char* ruta, unsigned long long numTramas) {
+        int fd = ::open(ruta, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return 0;
+        unsigned long long escritas = escribirEnDescriptor(fd, numTramas);
+        ::close(fd);
+        return escritas;
+    }
+
+    /**
+     * @brief Abre un pseudo-terminal para simular un puerto serial
+     * @param nombreEsclavo Salida: ruta del lado esclavo (ej: /dev/pts/3)
+     * @return Descriptor del lado maestro, o -1 si falla
+     *
+     * El consumidor abre nombreEsclavo como si fuera /dev/ttyUSB0 y el
+     * generador escribe en el descriptor devuelto.
+     */
+    static int abrirPty(std::string& nombreEsclavo) {
+        int maestro = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if (maestro < 0) return -1;
+        if (::grantpt(maestro) != 0 || ::unlockpt(maestro) != 0) {
+            ::close(maestro);
+            return -1;
+        }
+        const char* nombre = ::ptsname(maestro);
+        if (nombre == nullptr) {
+            ::close(maestro);
+            return -1;
+        }
+        nombreEsclavo = nombre;
+        return maestro;
+    }
+};
+
+#endif
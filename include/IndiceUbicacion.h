@@ -0,0 +1,176 @@
+/**
+ * @file IndiceUbicacion.h
+ * @brief Índice ubicación -> sensores con resúmenes por tipo precalculados
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef INDICE_UBICACION_H
+#define INDICE_UBICACION_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+#include "TiposSensor.h"
+
+class SensorBase;
+
+/**
+ * @struct ResumenTipoUbicacion
+ * @brief Cantidad, promedio, mínimo y máximo de las lecturas de un tipo en una ubicación
+ */
+struct ResumenTipoUbicacion {
+    int sensores;           ///< Sensores del tipo en la ubicación
+    long long lecturas;     ///< Lecturas de esos sensores
+    double suma;            ///< Suma de las lecturas
+    double minimo;          ///< Lectura mínima
+    double maximo;          ///< Lectura máxima
+
+    ResumenTipoUbicacion() : sensores(0), lecturas(0), suma(0.0), minimo(0.0), maximo(0.0) {}
+
+    /**
+     * @brief Incorpora una lectura
+     * @param valor Lectura
+     */
+    void registrar(double valor) {
+        if (lecturas == 0 || valor < minimo) minimo = valor;
+        if (lecturas == 0 || valor > maximo) maximo = valor;
+        suma += valor;
+        lecturas++;
+    }
+
+    /**
+     * @brief Incorpora el resumen de un sensor completo
+     * @param n Lecturas del sensor
+     * @param s Suma de sus lecturas
+     * @param mn Mínimo
+     * @param mx Máximo
+     */
+    void combinar(long long n, double s, double mn, double mx) {
+        if (n == 0) return;
+        if (lecturas == 0 || mn < minimo) minimo = mn;
+        if (lecturas == 0 || mx > maximo) maximo = mx;
+        suma += s;
+        lecturas += n;
+    }
+
+    /**
+     * @brief Promedio de las lecturas (0 si no hay)
+     */
+    double promedio() const {
+        return lecturas ? suma / lecturas : 0.0;
+    }
+};
+
+/**
+ * @struct ResumenUbicacion
+ * @brief Sensores de una ubicación y sus resúmenes por tipo
+ */
+struct ResumenUbicacion {
+    std::string ubicacion;                                   ///< Nombre de la ubicación
+    ResumenTipoUbicacion porTipo[NUM_TIPOS_SENSOR];          ///< Resumen de cada tipo
+    std::vector<SensorBase*> sensores;                       ///< Sensores presentes
+
+    /**
+     * @brief Incorpora una lectura de un sensor de la ubicación
+     * @param tipo Tipo del sensor
+     * @param valor Lectura
+     */
+    void registrar(TipoSensor tipo, double valor) {
+        porTipo[tipo].registrar(valor);
+    }
+};
+
+/**
+ * @class IndiceUbicacion
+ * @brief Índice secundario de ListaGestion por ubicación
+ *
+ * Cada sensor guarda un puntero a su ResumenUbicacion y lo actualiza
+ * en cada lectura, así que consultar una ubicación es O(1). Los
+ * resúmenes cubren las lecturas de los sensores presentes: al quitar
+ * un sensor se restan sus lecturas y, solo si aportaba el mínimo o el
+ * máximo, estos se recalculan con los demás sensores del mismo tipo
+ * de la ubicación.
+ */
+class IndiceUbicacion {
+private:
+    std::unordered_map<std::string, ResumenUbicacion*> porUbicacion;  ///< Ubicación -> resumen
+
+    IndiceUbicacion(const IndiceUbicacion&);
+    IndiceUbicacion& operator=(const IndiceUbicacion&);
+
+public:
+    /**
+     * @brief Constructor
+     */
+    IndiceUbicacion() {}
+
+    /**
+     * @brief Destructor: libera los resúmenes (no los sensores)
+     */
+    ~IndiceUbicacion() {
+        limpiar();
+    }
+
+    /**
+     * @brief Agrega un sensor a su ubicación
+     * @param sensor Sensor (aún sin lecturas volcadas)
+     * @param ubicacion Ubicación del sensor
+     * @param tipo Tipo del sensor
+     * @param posicion Salida: posición del sensor en ResumenUbicacion::sensores
+     * @return Resumen de la ubicación
+     */
+    ResumenUbicacion* agregar(SensorBase* sensor, const char* ubicacion, TipoSensor tipo,
+                              std::size_t& posicion) {
+        ResumenUbicacion*& resumen = porUbicacion[ubicacion];
+        if (resumen == nullptr) {
+            resumen = new ResumenUbicacion();
+            resumen->ubicacion = ubicacion;
+        }
+        resumen->porTipo[tipo].sensores++;
+        resumen->sensores.push_back(sensor);
+        posicion = resumen->sensores.size() - 1;
+        return resumen;
+    }
+
+    /**
+     * @brief Consulta una ubicación en O(1)
+     * @param ubicacion Nombre de la ubicación
+     * @return Resumen, o nullptr si no hay sensores allí
+     */
+    const ResumenUbicacion* buscar(const char* ubicacion) const {
+        std::unordered_map<std::string, ResumenUbicacion*>::const_iterator it = porUbicacion.find(ubicacion);
+        return it != porUbicacion.end() ? it->second : nullptr;
+    }
+
+    /**
+     * @brief Quita una ubicación vacía del índice
+     * @param resumen Resumen sin sensores
+     */
+    void descartarSiVacia(ResumenUbicacion* resumen) {
+        if (!resumen->sensores.empty()) return;
+        porUbicacion.erase(resumen->ubicacion);
+        delete resumen;
+    }
+
+    /**
+     * @brief Número de ubicaciones con sensores
+     */
+    std::size_t getCantidad() const {
+        return porUbicacion.size();
+    }
+
+    /**
+     * @brief Libera todos los resúmenes
+     */
+    void limpiar() {
+        for (std::unordered_map<std::string, ResumenUbicacion*>::iterator it = porUbicacion.begin();
+             it != porUbicacion.end(); ++it) {
+            delete it->second;
+        }
+        porUbicacion.clear();
+    }
+};
+
+#endif
@@ -0,0 +1,313 @@
+/**
+ * @file Ingesta.h
+ * @brief Creación de sensores y registro de lecturas a partir de texto
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef INGESTA_H
+#define INGESTA_H
+
+#include "TiposSensor.h"
+#include "SensorGenerico.h"
+#include "ListaGestion.h"
+#include "Metricas.h"
+#include "VentanaDeslizante.h"
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @struct CrearSensor
+ * @brief Crea un Sensor<Traits> y lo agrega a la lista
+ */
+template <typename Traits>
+struct CrearSensor {
+    /**
+     * @param lista Lista destino (dueña del sensor)
+     * @param id Identificador
+     * @param ubicacion Ubicación
+     * @return Sensor creado, o nullptr si ya existe uno con ese ID
+     */
+    static SensorBase* ejecutar(ListaGestion& lista, const char* id, const char* ubicacion) {
+        SensorBase* sensor = new Sensor<Traits>(id, ubicacion);
+        if (!lista.agregarSensor(sensor)) {
+            delete sensor;
+            return nullptr;
+        }
+        return sensor;
+    }
+};
+
+/**
+ * @struct AgregarLecturaTexto
+ * @brief Convierte el texto según Traits y lo agrega al sensor
+ *
+ * Solo se invoca a través de tablaLecturas(), indexada por el tipo
+ * real del sensor, por lo que el static_cast es seguro.
+ */
+template <typename Traits>
+struct AgregarLecturaTexto {
+    /**
+     * @param sensor Sensor de tipo Traits::tipo
+     * @param valor Texto de la lectura
+     * @param marcaMs Marca de tiempo de la lectura
+     * @param conMarca true si marcaMs es la marca del dispositivo
+     */
+    static void ejecutar(SensorBase* sensor, const char* valor, long long marcaMs, bool conMarca) {
+        Sensor<Traits>* destino = static_cast<Sensor<Traits>*>(sensor);
+        if (conMarca) destino->agregarLecturaConMarca(Traits::convertir(valor), marcaMs);
+        else destino->agregarLectura(Traits::convertir(valor), marcaMs);
+    }
+};
+
+typedef SensorBase* (*FuncionCrearSensor)(ListaGestion&, const char*, const char*);  ///< Firma de CrearSensor
+typedef void (*FuncionAgregarLectura)(SensorBase*, const char*, long long, bool);   ///< Firma de AgregarLecturaTexto
+
+/**
+ * @brief Tabla etiqueta de trama -> creación de sensor
+ */
+inline const TablaPorEtiqueta<CrearSensor, FuncionCrearSensor>& tablaCreacion() {
+    static const TablaPorEtiqueta<CrearSensor, FuncionCrearSensor> tabla;
+    return tabla;
+}
+
+/**
+ * @brief Tabla tipo de sensor -> registro de lectura
+ */
+inline const TablaPorTipo<AgregarLecturaTexto, FuncionAgregarLectura>& tablaLecturas() {
+    static const TablaPorTipo<AgregarLecturaTexto, FuncionAgregarLectura> tabla;
+    return tabla;
+}
+
+/**
+ * @brief Crea un sensor según la etiqueta de la trama
+ * @param lista Lista destino
+ * @param etiqueta Etiqueta ("TEMP", "PRES", "VIBR", ...)
+ * @param id Identificador
+ * @param ubicacion Ubicación
+ * @return Sensor creado, o nullptr si la etiqueta no está registrada
+ */
+inline SensorBase* crearSensorPorEtiqueta(ListaGestion& lista, const char* etiqueta,
+                                          const char* id, const char* ubicacion) {
+    FuncionCrearSensor crear = tablaCreacion().buscar(codigoEtiqueta(etiqueta));
+    return crear != nullptr ? crear(lista, id, ubicacion) : nullptr;
+}
+
+/**
+ * @brief Agrega una lectura en texto según el tipo real del sensor
+ * @param sensor Sensor destino
+ * @param valor Texto de la lectura
+ * @param marcaMs Marca de tiempo de la lectura
+ * @param conMarca true si marcaMs la puso el dispositivo (puede llegar fuera de orden);
+ *        false si es la hora local de llegada o una marca ya guardada (orden de llegada)
+ */
+inline void agregarLecturaTexto(SensorBase* sensor, const char* valor, long long marcaMs,
+                                bool conMarca = false) {
+    tablaLecturas()[sensor->getTipo()](sensor, valor, marcaMs, conMarca);
+}
+
+/**
+ * @brief Agrega una lectura en texto con la hora actual
+ * @param sensor Sensor destino
+ * @param valor Texto de la lectura
+ */
+inline void agregarLecturaTexto(SensorBase* sensor, const char* valor) {
+    agregarLecturaTexto(sensor, valor, ahoraMs());
+}
+
+/**
+ * @brief Vuelve a crear un sensor desalojado a partir de su archivo de derrame
+ * @param lista Lista destino
+ * @param id Identificador
+ * @return Sensor recargado, o nullptr si el ID no estaba en disco o el archivo no se pudo leer
+ *
+ * Las lecturas recuperadas conservan su marca de tiempo original.
+ */
+inline SensorBase* recargarSensor(ListaGestion& lista, const char* id) {
+    std::string ruta;
+    if (!lista.tomarDerramado(id, ruta)) return nullptr;
+
+    std::string etiqueta, ubicacion, lectura;
+    std::ifstream archivo(ruta.c_str());
+    if (!std::getline(archivo, etiqueta) || !std::getline(archivo, ubicacion)) {
+        return nullptr;
+    }
+    SensorBase* sensor = crearSensorPorEtiqueta(lista, etiqueta.c_str(), id, ubicacion.c_str());
+    if (sensor == nullptr) return nullptr;
+
+    while (archivo >> lectura) {
+        std::size_t arroba = lectura.find('@');
+        long long marcaMs = 0;
+        if (arroba != std::string::npos) {
+            marcaMs = std::strtoll(lectura.c_str() + arroba + 1, nullptr, 10);
+            lectura.resize(arroba);
+        }
+        agregarLecturaTexto(sensor, lectura.c_str(), marcaMs);
+    }
+    archivo.close();
+    std::remove(ruta.c_str());
+    Metricas::incrementar(CONTADOR_SENSORES_RECARGADOS);
+    return sensor;
+}
+
+/**
+ * @brief Busca un sensor en memoria y, si fue desalojado, lo recarga del disco
+ * @param lista Lista donde buscar
+ * @param id Identificador
+ * @return Sensor, o nullptr si no existe
+ */
+inline SensorBase* buscarORecargar(ListaGestion& lista, const char* id) {
+    SensorBase* sensor = lista.buscarPorId(id);
+    return sensor != nullptr ? sensor : recargarSensor(lista, id);
+}
+
+/**
+ * @brief Inserta en su historial las lecturas diferidas durante una exportación
+ * @param lista Lista con lecturas diferidas
+ * @return Lecturas aplicadas (0 si todavía hay instantáneas en uso)
+ *
+ * La llama el hilo que modifica la lista (ingerirTrama lo hace antes de
+ * cada trama). Las de sensores eliminados mientras tanto se descartan.
+ */
+inline int aplicarLecturasDiferidas(ListaGestion& lista) {
+    std::vector<LecturaDiferida> diferidas;
+    if (!lista.tomarDiferidas(diferidas)) return 0;
+
+    int aplicadas = 0;
+    for (std::size_t i = 0; i < diferidas.size(); i++) {
+        SensorBase* sensor = buscarORecargar(lista, diferidas[i].id.c_str());
+        if (sensor == nullptr) continue;
+        agregarLecturaTexto(sensor, diferidas[i].valor.c_str(), diferidas[i].marca, true);
+        aplicadas++;
+    }
+    return aplicadas;
+}
+
+/**
+ * @struct TramaSensor
+ * @brief Campos de una trama "TIPO:ID:VALOR[:MARCA]"
+ */
+struct TramaSensor {
+    char tipo[10];   ///< Etiqueta del tipo ("TEMP", "PRES", ...)
+    char id[20];     ///< Identificador del sensor
+    char valor[20];  ///< Lectura en texto
+    long long marca; ///< Marca de tiempo del dispositivo en ms (0 = sin marca)
+};
+
+/**
+ * @brief Copia un campo de la trama hasta ':' o el final
+ * @param texto Inicio del campo
+ * @param fin Fin de la trama
+ * @param destino Buffer destino
+ * @param capacidad Tamaño del buffer destino
+ * @return Puntero al separador (o fin); nullptr si el campo no cabe
+ */
+inline const char* copiarCampoTrama(const char* texto, const char* fin,
+                                    char* destino, std::size_t capacidad) {
+    std::size_t n = 0;
+    while (texto + n < fin && texto[n] != ':') {
+        n++;
+    }
+    if (n >= capacidad) return nullptr;
+    std::memcpy(destino, texto, n);
+    destino[n] = '\0';
+    return texto + n;
+}
+
+/**
+ * @brief Lee la marca de tiempo decimal de una trama
+ * @param texto Inicio del campo
+ * @param fin Fin de la trama
+ * @param marca Salida: marca en ms
+ * @return true si el campo son solo dígitos (como máximo 18)
+ */
+inline bool leerMarcaTrama(const char* texto, const char* fin, long long& marca) {
+    if (texto == fin || fin - texto > 18) return false;
+    marca = 0;
+    for (; texto < fin; texto++) {
+        if (*texto < '0' || *texto > '9') return false;
+        marca = marca * 10 + (*texto - '0');
+    }
+    return true;
+}
+
+/**
+ * @brief Separa una trama "TIPO:ID:VALOR[:MARCA]" sin modificar el texto
+ * @param texto Inicio de la trama (no necesita terminar en '\0')
+ * @param longitud Bytes de la trama, sin el salto de línea
+ * @param trama Salida: campos separados
+ * @return true si la trama tiene tres campos que caben en TramaSensor
+ *         y, si trae un cuarto, es una marca válida
+ *
+ * A diferencia de strtok no guarda estado, así que la pueden usar
+ * varios hilos y buffers que reciben datos parciales. La marca la
+ * ponen las pasarelas que reenvían lecturas con su hora de origen.
+ */
+inline bool parsearTrama(const char* texto, std::size_t longitud, TramaSensor& trama) {
+    CronometroMetrica cronometro(LATENCIA_PARSEO);
+    const char* fin = texto + longitud;
+    if (longitud > 0 && fin[-1] == '\r') fin--;
+    trama.marca = 0;
+
+    const char* p = copiarCampoTrama(texto, fin, trama.tipo, sizeof(trama.tipo));
+    if (p == nullptr || p == fin) return false;
+    p = copiarCampoTrama(p + 1, fin, trama.id, sizeof(trama.id));
+    if (p == nullptr || p == fin) return false;
+    p = copiarCampoTrama(p + 1, fin, trama.valor, sizeof(trama.valor));
+    if (p == nullptr || trama.id[0] == '\0') return false;
+    return p == fin || leerMarcaTrama(p + 1, fin, trama.marca);
+}
+
+/**
+ * @brief Registra una trama ya separada: busca (o recarga) el sensor, lo crea si no existe y agrega la lectura
+ * @param lista Lista destino
+ * @param trama Campos de la trama
+ * @param ubicacion Ubicación para los sensores creados
+ * @param marcaMs Marca de la trama si la trae; si no, hora local de llegada
+ * @return Sensor que recibió la lectura, o nullptr si la etiqueta no está registrada
+ *
+ * Si la trama trae marca y el sensor ya aceptó la misma marca con el
+ * mismo valor, es una retransmisión: Sensor::agregarLecturaConMarca la
+ * cuenta y no la agrega. Las tramas sin marca se agregan en orden de
+ * llegada y no se filtran (ver FiltroDuplicados). Una trama con marca
+ * anterior a la más reciente de su dispositivo se inserta en orden en
+ * su historial; con una exportación en curso reenlazar nodos que otro
+ * hilo está leyendo no es seguro, así que se difiere hasta que termine.
+ */
+inline SensorBase* ingerirTrama(ListaGestion& lista, const TramaSensor& trama,
+                                const char* ubicacion, long long marcaMs) {
+    if (lista.hayDiferidas()) aplicarLecturasDiferidas(lista);
+    SensorBase* sensor = buscarORecargar(lista, trama.id);
+
+    // Si no existe, crearlo según la etiqueta
+    if (sensor == nullptr) {
+        CronometroMetrica cronometro(LATENCIA_CREACION);
+        sensor = crearSensorPorEtiqueta(lista, trama.tipo, trama.id, ubicacion);
+
+        if (sensor) {
+            Metricas::incrementar(CONTADOR_SENSORES_CREADOS);
+        } else {
+            Metricas::incrementar(CONTADOR_TRAMAS_INVALIDAS);
+        }
+    }
+
+    const bool conMarca = trama.marca != 0;
+    if (sensor && conMarca && sensor->esTardia(marcaMs) && lista.hayInstantaneas()) {
+        lista.diferirLectura(trama.id, trama.valor, marcaMs);
+        return sensor;
+    }
+
+    // Agregar lectura según el tipo real del sensor
+    if (sensor) {
+        CronometroMetrica cronometro(LATENCIA_AGREGAR_LECTURA);
+        agregarLecturaTexto(sensor, trama.valor, marcaMs, conMarca);
+    }
+    return sensor;
+}
+
+#endif
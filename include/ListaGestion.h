@@ -9,21 +9,131 @@
 #define LISTA_GESTION_H
 
 #include "SensorBase.h"
+#include "RegistroSensores.h"
+#include "IndiceUbicacion.h"
+#include "Metricas.h"
+#include "PoolHilos.h"
+#include "Rangos.h"
+#include "VentanaDeslizante.h"
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <cstdio>
 
 /**
  * @struct NodoSensor
  * @brief Nodo que almacena punteros a sensores (polimórfico)
+ *
+ * Está enlazado dos veces: en el orden de la lista (anterior/siguiente)
+ * y en el orden de uso (masReciente/menosReciente), de modo que quitar
+ * un nodo o marcarlo como usado es O(1).
  */
 struct NodoSensor {
     SensorBase* sensor;     ///< Puntero polimórfico a sensor
     NodoSensor* siguiente;  ///< Siguiente nodo
+    NodoSensor* anterior;   ///< Nodo anterior
+    NodoSensor* masReciente;    ///< Vecino usado más recientemente (orden LRU)
+    NodoSensor* menosReciente;  ///< Vecino usado menos recientemente (orden LRU)
+    long long ultimoUso;        ///< Marca en ms del último alta o búsqueda
     
     /**
      * @brief Constructor
      * @param s Puntero al sensor
      */
-    NodoSensor(SensorBase* s) : sensor(s), siguiente(nullptr) {}
+    NodoSensor(SensorBase* s)
+        : sensor(s), siguiente(nullptr), anterior(nullptr),
+          masReciente(nullptr), menosReciente(nullptr), ultimoUso(0) {}
+};
+
+/**
+ * @struct InstantaneaSensor
+ * @brief Foto del historial de un sensor: sus primeras cantidad lecturas
+ *
+ * Mientras haya instantáneas los historiales solo crecen por el final
+ * (ingerirTrama pospone las lecturas fuera de orden), así que los nodos
+ * de la foto no cambian aunque el sensor siga recibiendo lecturas.
+ */
+struct InstantaneaSensor {
+    std::string id;          ///< Identificador
+    TipoSensor tipo;         ///< Tipo (indica el Nodo<Valor> de historial)
+    unsigned int codigo;     ///< Etiqueta de trama (codigoEtiqueta)
+    const void* historial;   ///< Primer nodo
+    int cantidad;            ///< Lecturas incluidas
+};
+
+/**
+ * @struct LecturaDiferida
+ * @brief Lectura fuera de orden que llegó con instantáneas en uso
+ *
+ * Se guarda por ID y no por puntero: si el sensor se elimina o se
+ * desaloja antes de aplicarla, se busca (o recarga) al aplicarla.
+ */
+struct LecturaDiferida {
+    std::string id;      ///< Identificador del sensor
+    std::string valor;   ///< Lectura en texto
+    long long marca;     ///< Marca del dispositivo
+};
+
+/**
+ * @class IteradorSensores
+ * @brief Iterador de avance sobre los sensores de una ListaGestion, en el orden de la lista
+ *
+ * Recorrer no cuenta como uso: no mueve a los sensores en el orden
+ * de desalojo, a diferencia de ListaGestion::buscarPorId.
+ */
+class IteradorSensores {
+private:
+    const NodoSensor* actual;  ///< Nodo actual (nullptr = fin)
+
+public:
+    typedef std::forward_iterator_tag iterator_category;  ///< Categoría del iterador
+    typedef SensorBase* value_type;                       ///< Tipo del elemento
+    typedef std::ptrdiff_t difference_type;               ///< Distancia entre iteradores
+    typedef SensorBase* const* pointer;                   ///< Puntero al elemento
+    typedef SensorBase* const& reference;                 ///< Referencia al elemento
+
+    /**
+     * @brief Constructor (iterador de fin)
+     */
+    IteradorSensores() : actual(nullptr) {}
+
+    /**
+     * @brief Constructor
+     * @param nodo Nodo inicial (nullptr = fin)
+     */
+    explicit IteradorSensores(const NodoSensor* nodo) : actual(nodo) {}
+
+    /**
+     * @brief Sensor actual
+     */
+    reference operator*() const { return actual->sensor; }
+    pointer operator->() const { return &actual->sensor; }
+
+    /**
+     * @brief Avanza al siguiente sensor
+     */
+    IteradorSensores& operator++() {
+        actual = actual->siguiente;
+        return *this;
+    }
+
+    IteradorSensores operator++(int) {
+        IteradorSensores previo(*this);
+        actual = actual->siguiente;
+        return previo;
+    }
+
+    bool operator==(const IteradorSensores& otro) const { return actual == otro.actual; }
+    bool operator!=(const IteradorSensores& otro) const { return actual != otro.actual; }
 };
 
 /**
@@ -31,12 +141,189 @@ struct NodoSensor {
  * @brief Lista enlazada de sensores con gestión polimórfica
  * 
  * Almacena punteros a SensorBase, permitiendo procesamiento
- * uniforme de diferentes tipos de sensores.
+ * uniforme de diferentes tipos de sensores. Además mantiene un índice
+ * por ID para búsquedas O(1) y un RegistroSensores con el resumen de
+ * cada sensor en columnas contiguas por tipo, de modo que los barridos
+ * de toda la flota no recorren la lista enlazada.
+ *
+ * Opcionalmente desaloja los sensores menos usados cuando se supera un
+ * máximo de sensores o cuando llevan demasiado tiempo sin recibir
+ * tramas. El desalojo es incremental (unos pocos sensores por alta) y,
+ * si hay un directorio de derrame, guarda las lecturas en disco para
+ * recargarlas cuando el sensor vuelva a aparecer (ver Ingesta.h).
+ *
+ * Mientras exista una instantánea tomada con tomarInstantanea() el
+ * desalojo se pospone, para que los historiales fotografiados sigan
+ * vivos aunque otro hilo los esté leyendo.
+ *
+ * begin()/end() recorren los sensores en orden; con dividirEnBloques y
+ * reducirParalelo (Rangos.h) se pueden escribir análisis de la flota
+ * que usan todos los núcleos sin tocar los nodos.
  */
 class ListaGestion {
+public:
+    typedef IteradorSensores const_iterator;  ///< Iterador sobre los sensores
+    typedef const_iterator iterator;          ///< La estructura no se modifica al recorrer
+    
+
+    static const int MINIMO_PARALELO = 256;  ///< Sensores mínimos para procesar en paralelo
+    static const int DESALOJOS_POR_PASO = 4; ///< Máximo de sensores desalojados por alta
+    
 private:
     NodoSensor* cabeza;  ///< Primer nodo
+    NodoSensor* cola;    ///< Último nodo (inserción O(1))
     int cantidad;        ///< Número de sensores
+    std::unordered_map<std::string, NodoSensor*> indice;  ///< ID -> nodo
+    RegistroSensores registro;                            ///< Resúmenes por tipo
+    IndiceUbicacion ubicaciones;                          ///< Ubicación -> sensores y resúmenes
+    NodoSensor* masReciente;    ///< Extremo más usado del orden LRU
+    NodoSensor* menosReciente;  ///< Extremo menos usado (próximo a desalojar)
+    int maxSensores;            ///< Presupuesto de sensores (0 = sin límite)
+    long long maxInactividadMs; ///< Inactividad máxima en ms (0 = sin límite)
+    std::string directorioDerrame;          ///< Destino de los desalojados ("" = descartar)
+    std::unordered_set<std::string> derramados;  ///< IDs guardados en disco
+    std::atomic<int> instantaneas;          ///< Instantáneas en uso (posponen el desalojo)
+    std::vector<SensorBase*> eliminados;    ///< Sensores quitados durante una instantánea, sin liberar
+    std::vector<LecturaDiferida> diferidas; ///< Lecturas fuera de orden llegadas durante una instantánea
+    
+    /**
+     * @brief Saca un nodo del orden LRU
+     */
+    void desenlazarUso(NodoSensor* nodo) {
+        if (nodo->masReciente) nodo->masReciente->menosReciente = nodo->menosReciente;
+        else masReciente = nodo->menosReciente;
+        if (nodo->menosReciente) nodo->menosReciente->masReciente = nodo->masReciente;
+        else menosReciente = nodo->masReciente;
+        nodo->masReciente = nodo->menosReciente = nullptr;
+    }
+    
+    /**
+     * @brief Pone un nodo en el extremo más reciente del orden LRU
+     */
+    void enlazarUso(NodoSensor* nodo) {
+        nodo->masReciente = nullptr;
+        nodo->menosReciente = masReciente;
+        if (masReciente) masReciente->masReciente = nodo;
+        else menosReciente = nodo;
+        masReciente = nodo;
+    }
+    
+    /**
+     * @brief Indica si el sensor menos usado debe desalojarse
+     * @param ahora Marca actual en ms
+     */
+    bool hayQueDesalojar(long long ahora) const {
+        if (menosReciente == nullptr) return false;
+        if (maxSensores > 0 && cantidad > maxSensores) return true;
+        return maxInactividadMs > 0 && ahora - menosReciente->ultimoUso > maxInactividadMs;
+    }
+    
+    /**
+     * @brief Archivo de derrame de un ID (en hexadecimal, válido en cualquier sistema de archivos)
+     */
+    std::string rutaDerrame(const std::string& id) const {
+        static const char digitos[] = "0123456789abcdef";
+        std::string ruta = directorioDerrame + "/";
+        for (std::size_t i = 0; i < id.size(); i++) {
+            unsigned char c = static_cast<unsigned char>(id[i]);
+            ruta += digitos[c >> 4];
+            ruta += digitos[c & 15];
+        }
+        return ruta + ".sensor";
+    }
+    
+    /**
+     * @brief Guarda etiqueta, ubicación y lecturas de un sensor
+     * @return true si se escribió el archivo
+     */
+    bool derramar(const SensorBase* sensor) {
+        std::ofstream archivo(rutaDerrame(sensor->getId()).c_str());
+        if (!archivo) return false;
+        unsigned int codigo = sensor->getCodigoEtiqueta();
+        for (int i = 0; i < 4; i++) {
+            archivo << static_cast<char>((codigo >> (8 * i)) & 0xFF);
+        }
+        archivo << "\n" << sensor->getUbicacion() << "\n";
+        sensor->guardarLecturas(archivo);
+        archivo << "\n";
+        return static_cast<bool>(archivo);
+    }
+    
+    /**
+     * @brief Quita un sensor del índice de ubicaciones y descuenta sus lecturas
+     *
+     * El mínimo y el máximo solo se recalculan (con los demás sensores
+     * del tipo en esa ubicación) si el sensor quitado los aportaba.
+     */
+    void quitarDeUbicacion(SensorBase* sensor) {
+        ResumenUbicacion* resumen = sensor->getResumenUbicacion();
+        if (resumen == nullptr) return;
+        
+        std::size_t posicion = sensor->getPosicionUbicacion();
+        SensorBase* ultimo = resumen->sensores.back();
+        resumen->sensores[posicion] = ultimo;
+        ultimo->vincularUbicacion(resumen, posicion);
+        resumen->sensores.pop_back();
+        sensor->vincularUbicacion(nullptr, 0);
+        
+        TipoSensor tipo = sensor->getTipo();
+        ResumenTipoUbicacion& porTipo = resumen->porTipo[tipo];
+        porTipo.sensores--;
+        
+        long long n = 0;
+        double suma = 0.0, minimo = 0.0, maximo = 0.0;
+        sensor->resumenLecturas(n, suma, minimo, maximo);
+        if (n > 0 && (n == porTipo.lecturas || minimo <= porTipo.minimo || maximo >= porTipo.maximo)) {
+            bool quedanLecturas = n != porTipo.lecturas;
+            int sensores = porTipo.sensores;
+            porTipo = ResumenTipoUbicacion();
+            porTipo.sensores = sensores;
+            for (std::size_t i = 0; quedanLecturas && i < resumen->sensores.size(); i++) {
+                if (resumen->sensores[i]->getTipo() != tipo) continue;
+                resumen->sensores[i]->resumenLecturas(n, suma, minimo, maximo);
+                porTipo.combinar(n, suma, minimo, maximo);
+            }
+        } else if (n > 0) {
+            porTipo.lecturas -= n;
+            porTipo.suma -= suma;
+        }
+        ubicaciones.descartarSiVacia(resumen);
+    }
+    
+    /**
+     * @brief Libera los sensores quitados mientras había instantáneas, si ya no las hay
+     */
+    void purgarEliminados() {
+        if (eliminados.empty() || instantaneas.load() > 0) return;
+        for (std::size_t i = 0; i < eliminados.size(); i++) {
+            delete eliminados[i];
+        }
+        eliminados.clear();
+    }
+    
+    /**
+     * @brief Quita un nodo de la lista, del índice y del registro y libera el sensor
+     *
+     * Si hay una instantánea en uso, su foto apunta al historial del
+     * sensor: el sensor queda en eliminados hasta purgarEliminados().
+     */
+    void quitarNodo(NodoSensor* nodo) {
+        if (nodo->anterior) nodo->anterior->siguiente = nodo->siguiente;
+        else cabeza = nodo->siguiente;
+        if (nodo->siguiente) nodo->siguiente->anterior = nodo->anterior;
+        else cola = nodo->anterior;
+        desenlazarUso(nodo);
+        
+        std::unordered_map<std::string, NodoSensor*>::iterator it = indice.find(nodo->sensor->getId());
+        if (it != indice.end() && it->second == nodo) indice.erase(it);
+        
+        quitarDeUbicacion(nodo->sensor);
+        nodo->sensor->desvincularRegistro();
+        if (instantaneas.load() > 0) eliminados.push_back(nodo->sensor);
+        else delete nodo->sensor;
+        delete nodo;
+        cantidad--;
+    }
     
     /**
      * @brief Libera memoria de todos los sensores
@@ -49,15 +336,80 @@ private:
             delete temp->sensor;  // Llama al destructor virtual
             delete temp;
         }
+        for (std::size_t i = 0; i < eliminados.size(); i++) {
+            delete eliminados[i];
+        }
+        eliminados.clear();
         cabeza = nullptr;
+        cola = nullptr;
+        masReciente = nullptr;
+        menosReciente = nullptr;
         cantidad = 0;
+        indice.clear();
+        ubicaciones.limpiar();
+        registro = RegistroSensores();
     }
     
+    /**
+     * @struct ImpresorResumen
+     * @brief Imprime una línea del resumen de flota por cada tipo
+     */
+    struct ImpresorResumen {
+        /**
+         * @brief Resume las columnas de un tipo
+         */
+        template <typename Traits>
+        void visitar(const ColumnasResumen<typename Traits::Valor>& columnas) {
+            std::size_t conLecturas = 0;
+            std::size_t enAlerta = 0;
+            columnas.contarAlertas(conLecturas, enAlerta);
+            std::cout << "  " << Traits::nombre() << ": " << columnas.tamano() << " sensores, "
+                      << conLecturas << " con lecturas, " << enAlerta << " en alerta, "
+                      << "promedio global " << columnas.promedioGlobal() << std::endl;
+        }
+    };
+    
+    /**
+     * @struct BuscadorRanking
+     * @brief Calcula el ranking sobre las columnas del tipo pedido
+     */
+    struct BuscadorRanking {
+        TipoSensor tipo;                       ///< Tipo consultado
+        CampoRanking campo;                    ///< Estadística
+        std::size_t k;                         ///< Tamaño del ranking
+        bool mayores;                          ///< true = top-K
+        std::vector<EntradaRanking>* resultado;  ///< Destino
+        
+        /**
+         * @brief Ordena las columnas si son del tipo consultado
+         */
+        template <typename Traits>
+        void visitar(const ColumnasResumen<typename Traits::Valor>& columnas) {
+            if (Traits::tipo == tipo) {
+                columnas.ranking(campo, k, mayores, *resultado);
+            }
+        }
+    };
+    
+    /**
+     * @brief Procesa un sensor escribiendo su encabezado y resultado
+     */
+    static void procesarSensor(SensorBase* sensor, std::ostream& salida) {
+        salida << "\nSensor: " << sensor->getId() << "\n";
+        sensor->procesarLectura(salida);  // Llamada polimórfica
+    }
+    
+    // La lista es dueña de los sensores: no se copia
+    ListaGestion(const ListaGestion&);
+    ListaGestion& operator=(const ListaGestion&);
+    
 public:
     /**
      * @brief Constructor
      */
-    ListaGestion() : cabeza(nullptr), cantidad(0) {}
+    ListaGestion()
+        : cabeza(nullptr), cola(nullptr), cantidad(0), masReciente(nullptr),
+          menosReciente(nullptr), maxSensores(0), maxInactividadMs(0), instantaneas(0) {}
     
     /**
      * @brief Destructor
@@ -67,39 +419,222 @@ public:
     }
     
     /**
-     * @brief Agrega un sensor a la lista
-     * @param sensor Puntero al sensor (será propiedad de la lista)
+     * @brief Agrega un sensor a la lista en O(1)
+     * @param sensor Puntero al sensor (pasa a ser propiedad de la lista si se agrega)
+     * @return false si ya hay un sensor en memoria con el mismo ID (no se agrega)
+     *
+     * Si el ID estaba derramado en disco, ese archivo se borra: el
+     * sensor nuevo lo reemplaza y buscarORecargar no debe revivir las
+     * lecturas viejas. Si hay política de desalojo, después del alta
+     * se desalojan a lo sumo DESALOJOS_POR_PASO sensores.
      */
-    void agregarSensor(SensorBase* sensor) {
+    bool agregarSensor(SensorBase* sensor) {
+        if (indice.find(sensor->getId()) != indice.end()) return false;
+        std::string ruta;
+        if (tomarDerramado(sensor->getId(), ruta)) {
+            std::remove(ruta.c_str());
+        }
+        
         NodoSensor* nuevo = new NodoSensor(sensor);
         
         if (cabeza == nullptr) {
             cabeza = nuevo;
         } else {
-            NodoSensor* actual = cabeza;
-            while (actual->siguiente != nullptr) {
-                actual = actual->siguiente;
-            }
-            actual->siguiente = nuevo;
+            cola->siguiente = nuevo;
+            nuevo->anterior = cola;
         }
+        cola = nuevo;
         
+        indice.insert(std::make_pair(std::string(sensor->getId()), nuevo));
+        std::size_t posicion = 0;
+        ResumenUbicacion* resumen = ubicaciones.agregar(sensor, sensor->getUbicacion(),
+                                                        sensor->getTipo(), posicion);
+        sensor->vincularUbicacion(resumen, posicion);
+        sensor->vincularRegistro(&registro);
         cantidad++;
+        
+        nuevo->ultimoUso = maxInactividadMs > 0 ? ahoraMs() : 0;
+        enlazarUso(nuevo);
+        desalojar(DESALOJOS_POR_PASO);
+        return true;
     }
     
     /**
-     * @brief Busca un sensor por ID
+     * @brief Busca un sensor por ID en O(1) y lo marca como usado
      * @param id Identificador a buscar
      * @return Puntero al sensor o nullptr si no existe
      */
     SensorBase* buscarPorId(const char* id) {
-        NodoSensor* actual = cabeza;
-        while (actual != nullptr) {
-            if (strcmp(actual->sensor->getId(), id) == 0) {
-                return actual->sensor;
+        CronometroMetrica cronometro(LATENCIA_BUSQUEDA);
+        std::unordered_map<std::string, NodoSensor*>::const_iterator it = indice.find(id);
+        if (it == indice.end()) return nullptr;
+        
+        NodoSensor* nodo = it->second;
+        if (maxInactividadMs > 0) nodo->ultimoUso = ahoraMs();
+        if (nodo != masReciente) {
+            desenlazarUso(nodo);
+            enlazarUso(nodo);
+        }
+        return nodo->sensor;
+    }
+    
+    /**
+     * @brief Elimina un sensor por ID en O(1), también si estaba derramado en disco
+     * @param id Identificador
+     * @return true si existía
+     *
+     * Con una instantánea en uso el sensor deja la lista de inmediato,
+     * pero su memoria se libera recién cuando no quedan instantáneas.
+     */
+    bool eliminarSensor(const char* id) {
+        purgarEliminados();
+        std::unordered_map<std::string, NodoSensor*>::iterator it = indice.find(id);
+        if (it != indice.end()) {
+            quitarNodo(it->second);
+            return true;
+        }
+        std::string ruta;
+        if (tomarDerramado(id, ruta)) {
+            std::remove(ruta.c_str());
+            return true;
+        }
+        return false;
+    }
+    
+    /**
+     * @brief Configura la política de desalojo
+     * @param maximo Máximo de sensores en memoria (0 = sin límite)
+     * @param inactividadMs Tiempo sin tramas tras el cual se desaloja (0 = sin límite)
+     * @param directorio Directorio existente donde guardar los desalojados ("" = descartarlos)
+     *
+     * No desaloja nada de inmediato: el exceso se va quitando de a
+     * poco en cada alta o en cada llamada a desalojar().
+     */
+    void configurarDesalojo(int maximo, long long inactividadMs, const std::string& directorio) {
+        maxSensores = maximo > 0 ? maximo : 0;
+        maxInactividadMs = inactividadMs > 0 ? inactividadMs : 0;
+        directorioDerrame = directorio;
+        
+        // Sin marcas previas, el reloj de inactividad arranca ahora
+        long long ahora = ahoraMs();
+        for (NodoSensor* nodo = masReciente; nodo != nullptr; nodo = nodo->menosReciente) {
+            if (nodo->ultimoUso == 0) nodo->ultimoUso = ahora;
+        }
+    }
+    
+    /**
+     * @brief Desaloja sensores menos usados que excedan la política
+     * @param maximo Máximo de sensores a desalojar en esta llamada
+     * @return Sensores desalojados
+     *
+     * Pensado para llamarse seguido (p. ej. una vez por lote de
+     * tramas): cada llamada hace un trabajo acotado.
+     */
+    int desalojar(int maximo) {
+        purgarEliminados();
+        if (maxSensores == 0 && maxInactividadMs == 0) return 0;
+        if (instantaneas.load() > 0) return 0;  // Se retoma al liberar la instantánea
+        
+        long long ahora = maxInactividadMs > 0 ? ahoraMs() : 0;
+        int desalojados = 0;
+        while (desalojados < maximo && hayQueDesalojar(ahora)) {
+            NodoSensor* victima = menosReciente;
+            if (!directorioDerrame.empty() && derramar(victima->sensor)) {
+                derramados.insert(victima->sensor->getId());
             }
-            actual = actual->siguiente;
+            quitarNodo(victima);
+            Metricas::incrementar(CONTADOR_SENSORES_DESALOJADOS);
+            desalojados++;
+        }
+        return desalojados;
+    }
+    
+    /**
+     * @brief Fotografía el historial de todos los sensores, en el orden de la lista
+     * @param salida Destino (se reemplaza su contenido)
+     *
+     * Debe llamarse desde el hilo que modifica la lista; recorrer la
+     * foto puede hacerse luego en otro hilo mientras sigue la ingesta.
+     * Hasta llamar a liberarInstantanea() no se desaloja ningún sensor
+     * y los que se eliminen se liberan recién después.
+     */
+    void tomarInstantanea(std::vector<InstantaneaSensor>& salida) {
+        instantaneas.fetch_add(1);
+        salida.clear();
+        salida.reserve(static_cast<std::size_t>(cantidad));
+        for (NodoSensor* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+            InstantaneaSensor foto;
+            foto.id = actual->sensor->getId();
+            foto.tipo = actual->sensor->getTipo();
+            foto.codigo = actual->sensor->getCodigoEtiqueta();
+            foto.historial = actual->sensor->getHistorial(foto.cantidad);
+            salida.push_back(foto);
         }
-        return nullptr;
+    }
+    
+    /**
+     * @brief Indica que una instantánea ya no se usa
+     */
+    void liberarInstantanea() {
+        instantaneas.fetch_sub(1);
+    }
+    
+    /**
+     * @brief Indica si hay instantáneas en uso
+     */
+    bool hayInstantaneas() const {
+        return instantaneas.load() > 0;
+    }
+    
+    /**
+     * @brief Guarda una lectura fuera de orden hasta que no haya instantáneas
+     * @param id Identificador del sensor
+     * @param valor Lectura en texto
+     * @param marca Marca del dispositivo
+     *
+     * Insertarla ahora reenlazaría nodos que otro hilo está leyendo;
+     * la aplica aplicarLecturasDiferidas() (Ingesta.h).
+     */
+    void diferirLectura(const char* id, const char* valor, long long marca) {
+        LecturaDiferida lectura;
+        lectura.id = id;
+        lectura.valor = valor;
+        lectura.marca = marca;
+        diferidas.push_back(lectura);
+    }
+    
+    /**
+     * @brief Indica si quedan lecturas diferidas
+     */
+    bool hayDiferidas() const {
+        return !diferidas.empty();
+    }
+    
+    /**
+     * @brief Entrega las lecturas diferidas si ya no hay instantáneas
+     * @param salida Destino (se reemplaza su contenido)
+     * @return false si todavía hay instantáneas (no entrega nada)
+     */
+    bool tomarDiferidas(std::vector<LecturaDiferida>& salida) {
+        salida.clear();
+        if (instantaneas.load() > 0) return false;
+        salida.swap(diferidas);
+        return true;
+    }
+    
+    /**
+     * @brief Toma el archivo de derrame de un ID desalojado
+     * @param id Identificador
+     * @param ruta Salida: archivo con etiqueta, ubicación y lecturas
+     * @return true si el ID estaba en disco (deja de estarlo para la lista)
+     */
+    bool tomarDerramado(const char* id, std::string& ruta) {
+        if (derramados.empty()) return false;
+        std::unordered_set<std::string>::iterator it = derramados.find(id);
+        if (it == derramados.end()) return false;
+        ruta = rutaDerrame(*it);
+        derramados.erase(it);
+        return true;
     }
     
     /**
@@ -109,19 +644,60 @@ public:
      * despachado dinámico (virtual).
      */
     void procesarTodosSensores() {
+        procesarTodosSensores(std::cout, nullptr);
+    }
+    
+    /**
+     * @brief Procesa todos los sensores, opcionalmente en paralelo
+     * @param salida Flujo destino
+     * @param pool Pool de hilos (nullptr o un solo hilo = modo serial)
+     *
+     * En modo paralelo los sensores se reparten en bloques entre los
+     * hilos del pool; cada bloque escribe en su propio buffer y al final
+     * los buffers se emiten en el orden de la lista, por lo que la salida
+     * es idéntica a la del modo serial. Listas pequeñas se procesan en
+     * serie porque el reparto costaría más que el trabajo.
+     */
+    void procesarTodosSensores(std::ostream& salida, PoolHilos* pool) {
         if (cantidad == 0) {
-            std::cout << "\nNo hay sensores registrados" << std::endl;
+            salida << "\nNo hay sensores registrados" << std::endl;
             return;
         }
         
-        std::cout << "\n=== Procesando " << cantidad << " sensores ===" << std::endl;
+        CronometroMetrica cronometro(LATENCIA_PROCESAMIENTO);
+        salida << "\n=== Procesando " << cantidad << " sensores ===" << std::endl;
         
-        NodoSensor* actual = cabeza;
-        while (actual != nullptr) {
-            std::cout << "\nSensor: " << actual->sensor->getId() << std::endl;
-            actual->sensor->procesarLectura();  // Llamada polimórfica
-            actual = actual->siguiente;
+        if (pool == nullptr || pool->getNumHilos() <= 1 || cantidad < MINIMO_PARALELO) {
+            NodoSensor* actual = cabeza;
+            while (actual != nullptr) {
+                procesarSensor(actual->sensor, salida);
+                actual = actual->siguiente;
+            }
+            return;
         }
+        
+        // Varios bloques por hilo para que el robo de trabajo equilibre la carga
+        std::vector<Rango<const_iterator> > bloques =
+            dividirEnBloques(*this, pool->getNumHilos() * BLOQUES_POR_HILO);
+        std::vector<std::string> resultados(bloques.size());
+        
+        for (std::size_t b = 0; b < bloques.size(); b++) {
+            const Rango<const_iterator>* bloque = &bloques[b];
+            std::string* destino = &resultados[b];
+            pool->enviar([bloque, destino] {
+                std::ostringstream buffer;
+                for (SensorBase* sensor : *bloque) {
+                    procesarSensor(sensor, buffer);
+                }
+                *destino = buffer.str();
+            });
+        }
+        pool->esperar();
+        
+        for (std::size_t b = 0; b < resultados.size(); b++) {
+            salida << resultados[b];
+        }
+        salida.flush();
     }
     
     /**
@@ -142,6 +718,86 @@ public:
         }
     }
     
+    /**
+     * @brief Muestra el resumen de toda la flota
+     *
+     * Solo recorre las columnas del registro (memoria contigua), sin
+     * tocar la lista enlazada ni los historiales.
+     */
+    void mostrarResumenFlota() const {
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+        
+        std::cout << "\n=== Resumen de flota: " << cantidad << " sensores ===" << std::endl;
+        ImpresorResumen impresor;
+        registro.visitar(impresor);
+        
+        std::chrono::duration<double, std::milli> duracion =
+            std::chrono::steady_clock::now() - inicio;
+        std::cout << "  Barrido: " << duracion.count() << " ms" << std::endl;
+    }
+    
+    /**
+     * @brief Top-K o bottom-K de los sensores de un tipo
+     * @param tipo Tipo de sensor
+     * @param campo Estadística (promedio, máximo, último, tasa)
+     * @param k Tamaño del ranking
+     * @param mayores true = mayores valores, false = menores
+     * @param resultado Salida: del primero al último del ranking
+     *
+     * Solo recorre las columnas del tipo, sin tocar los historiales.
+     */
+    void ranking(TipoSensor tipo, CampoRanking campo, std::size_t k, bool mayores,
+                 std::vector<EntradaRanking>& resultado) const {
+        resultado.clear();
+        BuscadorRanking buscador = { tipo, campo, k, mayores, &resultado };
+        registro.visitar(buscador);
+    }
+    
+    /**
+     * @brief Consulta una ubicación en O(1)
+     * @param ubicacion Nombre de la ubicación
+     * @return Sensores y resúmenes por tipo, o nullptr si no hay sensores allí
+     */
+    const ResumenUbicacion* buscarUbicacion(const char* ubicacion) const {
+        return ubicaciones.buscar(ubicacion);
+    }
+    
+    /**
+     * @brief Número de ubicaciones distintas
+     */
+    std::size_t getCantidadUbicaciones() const {
+        return ubicaciones.getCantidad();
+    }
+    
+    /**
+     * @brief Obtiene el registro de resúmenes por tipo
+     * @return Referencia constante al registro
+     */
+    const RegistroSensores& getRegistro() const {
+        return registro;
+    }
+    
+    /**
+     * @brief Cantidad de sensores guardados en disco
+     */
+    std::size_t getCantidadDerramados() const {
+        return derramados.size();
+    }
+    
+    /**
+     * @brief Iterador al primer sensor
+     */
+    const_iterator begin() const {
+        return const_iterator(cabeza);
+    }
+    
+    /**
+     * @brief Iterador de fin
+     */
+    const_iterator end() const {
+        return const_iterator();
+    }
+    
     /**
      * @brief Obtiene la cantidad de sensores
      * @return Número de sensores
@@ -9,6 +9,8 @@
 #define LISTA_SENSOR_H
 
 #include <iostream>
+#include <iterator>
+#include <cstddef>
 
 /**
  * @struct Nodo
@@ -18,13 +20,75 @@
 template <typename T>
 struct Nodo {
     T dato;         ///< Dato almacenado
+    long long marca; ///< Marca de tiempo en ms (0 = sin marca)
     Nodo* siguiente; ///< Puntero al siguiente nodo
     
     /**
      * @brief Constructor
      * @param valor Valor a almacenar
+     * @param m Marca de tiempo
      */
-    Nodo(T valor) : dato(valor), siguiente(nullptr) {}
+    Nodo(T valor, long long m = 0) : dato(valor), marca(m), siguiente(nullptr) {}
+};
+
+/**
+ * @class IteradorLista
+ * @brief Iterador de avance (forward) de solo lectura sobre una ListaSensor
+ * @tparam T Tipo de dato almacenado
+ *
+ * Cumple los requisitos de ForwardIterator, así que sirve para un for
+ * de rango y para los algoritmos de <algorithm> y <numeric>.
+ */
+template <typename T>
+class IteradorLista {
+private:
+    const Nodo<T>* actual;  ///< Nodo actual (nullptr = fin)
+
+public:
+    typedef std::forward_iterator_tag iterator_category;  ///< Categoría del iterador
+    typedef T value_type;                                 ///< Tipo del elemento
+    typedef std::ptrdiff_t difference_type;               ///< Distancia entre iteradores
+    typedef const T* pointer;                             ///< Puntero al elemento
+    typedef const T& reference;                           ///< Referencia al elemento
+
+    /**
+     * @brief Constructor (iterador de fin)
+     */
+    IteradorLista() : actual(nullptr) {}
+
+    /**
+     * @brief Constructor
+     * @param nodo Nodo inicial (nullptr = fin)
+     */
+    explicit IteradorLista(const Nodo<T>* nodo) : actual(nodo) {}
+
+    /**
+     * @brief Elemento actual
+     */
+    reference operator*() const { return actual->dato; }
+    pointer operator->() const { return &actual->dato; }
+
+    /**
+     * @brief Marca de tiempo de la lectura actual
+     */
+    long long marca() const { return actual->marca; }
+
+    /**
+     * @brief Avanza al siguiente nodo
+     */
+    IteradorLista& operator++() {
+        actual = actual->siguiente;
+        return *this;
+    }
+
+    IteradorLista operator++(int) {
+        IteradorLista previo(*this);
+        actual = actual->siguiente;
+        return previo;
+    }
+
+    bool operator==(const IteradorLista& otro) const { return actual == otro.actual; }
+    bool operator!=(const IteradorLista& otro) const { return actual != otro.actual; }
 };
 
 /**
@@ -34,13 +98,37 @@ struct Nodo {
  * 
  * Implementa la Regla de Tres (constructor copia, operador=, destructor)
  * para gestión correcta de memoria dinámica.
+ *
+ * Con agregar() un nodo no cambia después de enlazado, así que los
+ * primeros n nodos a partir de la cabeza forman una foto estable que
+ * otro hilo puede leer mientras se siguen agregando elementos (sin
+ * leer el siguiente del n-ésimo). insertarOrdenado() sí reenlaza un
+ * nodo de las últimas VENTANA_INSERCION posiciones: no debe usarse
+ * mientras otro hilo lee una foto.
  */
 template <typename T>
 class ListaSensor {
+public:
+    typedef IteradorLista<T> const_iterator;  ///< Iterador de solo lectura
+    typedef const_iterator iterator;          ///< Los elementos no se modifican en sitio
+    
+    static const int VENTANA_INSERCION = 64;  ///< Últimas posiciones donde se inserta fuera de orden
+
 private:
     Nodo<T>* cabeza;  ///< Puntero al primer nodo
+    Nodo<T>* cola;    ///< Puntero al último nodo (inserción O(1))
+    Nodo<T>* ancla;   ///< Primero de los últimos VENTANA_INSERCION nodos
     int cantidad;     ///< Número de elementos
     
+    /**
+     * @brief Mantiene el ancla después de enlazar un nodo (cantidad ya incrementada)
+     * @param detras true si el nodo quedó después del ancla
+     */
+    void moverAncla(bool detras) {
+        if (cantidad <= VENTANA_INSERCION) ancla = cabeza;
+        else if (detras) ancla = ancla->siguiente;
+    }
+    
     /**
      * @brief Libera toda la memoria de la lista
      */
@@ -52,6 +140,8 @@ private:
             delete temp;
         }
         cabeza = nullptr;
+        cola = nullptr;
+        ancla = nullptr;
         cantidad = 0;
     }
     
@@ -62,28 +152,35 @@ private:
     void copiar(const ListaSensor& otra) {
         if (otra.cabeza == nullptr) {
             cabeza = nullptr;
+            cola = nullptr;
+            ancla = nullptr;
             cantidad = 0;
             return;
         }
         
-        cabeza = new Nodo<T>(otra.cabeza->dato);
+        cabeza = new Nodo<T>(otra.cabeza->dato, otra.cabeza->marca);
         Nodo<T>* actualOtra = otra.cabeza->siguiente;
         Nodo<T>* actualEsta = cabeza;
         
         while (actualOtra != nullptr) {
-            actualEsta->siguiente = new Nodo<T>(actualOtra->dato);
+            actualEsta->siguiente = new Nodo<T>(actualOtra->dato, actualOtra->marca);
             actualEsta = actualEsta->siguiente;
             actualOtra = actualOtra->siguiente;
         }
         
+        cola = actualEsta;
         cantidad = otra.cantidad;
+        ancla = cabeza;
+        for (int i = VENTANA_INSERCION; i < cantidad; i++) {
+            ancla = ancla->siguiente;
+        }
     }
     
 public:
     /**
      * @brief Constructor por defecto
      */
-    ListaSensor() : cabeza(nullptr), cantidad(0) {}
+    ListaSensor() : cabeza(nullptr), cola(nullptr), ancla(nullptr), cantidad(0) {}
     
     /**
      * @brief Destructor
@@ -96,7 +193,7 @@ public:
      * @brief Constructor de copia (Regla de Tres)
      * @param otra Lista a copiar
      */
-    ListaSensor(const ListaSensor& otra) : cabeza(nullptr), cantidad(0) {
+    ListaSensor(const ListaSensor& otra) : cabeza(nullptr), cola(nullptr), ancla(nullptr), cantidad(0) {
         copiar(otra);
     }
     
@@ -114,23 +211,109 @@ public:
     }
     
     /**
-     * @brief Agrega un elemento al final
+     * @brief Agrega un elemento al final en O(1)
      * @param valor Valor a agregar
+     * @param marca Marca de tiempo en ms
      */
-    void agregar(T valor) {
-        Nodo<T>* nuevo = new Nodo<T>(valor);
+    void agregar(T valor, long long marca = 0) {
+        Nodo<T>* nuevo = new Nodo<T>(valor, marca);
         
         if (cabeza == nullptr) {
             cabeza = nuevo;
         } else {
-            Nodo<T>* actual = cabeza;
-            while (actual->siguiente != nullptr) {
-                actual = actual->siguiente;
+            cola->siguiente = nuevo;
+        }
+        cola = nuevo;
+        
+        cantidad++;
+        moverAncla(true);
+    }
+    
+    /**
+     * @brief Inserta un elemento en orden de marca, buscando solo en las últimas posiciones
+     * @param valor Valor a agregar
+     * @param marca Marca de tiempo en ms
+     * @return false si la marca es menor que todas las de los últimos
+     *         VENTANA_INSERCION elementos (no se inserta)
+     *
+     * Si la marca no es menor que la de la cola equivale a agregar().
+     * Si no, recorre a lo sumo VENTANA_INSERCION nodos desde el ancla;
+     * con marcas iguales el nuevo queda después de los existentes.
+     */
+    bool insertarOrdenado(T valor, long long marca) {
+        if (cola == nullptr || marca >= cola->marca) {
+            agregar(valor, marca);
+            return true;
+        }
+        
+        Nodo<T>* previo = nullptr;
+        if (marca >= ancla->marca) {
+            previo = ancla;
+            while (previo->siguiente->marca <= marca) {
+                previo = previo->siguiente;
             }
-            actual->siguiente = nuevo;
+        } else if (ancla != cabeza) {
+            return false;
         }
         
+        Nodo<T>* nuevo = new Nodo<T>(valor, marca);
+        if (previo == nullptr) {
+            nuevo->siguiente = cabeza;
+            cabeza = nuevo;
+        } else {
+            nuevo->siguiente = previo->siguiente;
+            previo->siguiente = nuevo;
+        }
         cantidad++;
+        moverAncla(previo != nullptr);
+        return true;
+    }
+    
+    /**
+     * @brief Aplica una función a cada elemento, en orden
+     * @param funcion Función o lambda que recibe const T&
+     */
+    template <typename F>
+    void recorrer(F funcion) const {
+        for (Nodo<T>* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+            funcion(actual->dato);
+        }
+    }
+    
+    /**
+     * @brief Aplica una función a cada elemento y su marca, en orden
+     * @param funcion Función o lambda que recibe (const T&, long long)
+     */
+    template <typename F>
+    void recorrerConMarca(F funcion) const {
+        for (Nodo<T>* actual = cabeza; actual != nullptr; actual = actual->siguiente) {
+            funcion(actual->dato, actual->marca);
+        }
+    }
+    
+    /**
+     * @brief Iterador al primer elemento
+     */
+    const_iterator begin() const {
+        return const_iterator(cabeza);
+    }
+    
+    /**
+     * @brief Iterador de fin
+     *
+     * Para recorrer una foto mientras otro hilo agrega, usar los
+     * primeros n elementos desde begin() en lugar de llegar a end().
+     */
+    const_iterator end() const {
+        return const_iterator();
+    }
+    
+    /**
+     * @brief Obtiene el primer nodo (para recorridos de solo lectura)
+     * @return Puntero a la cabeza, o nullptr si está vacía
+     */
+    const Nodo<T>* getCabeza() const {
+        return cabeza;
     }
     
     /**
@@ -0,0 +1,504 @@
+/**
+ * @file Metricas.h
+ * @brief Contadores e histogramas de latencia de bajo costo para rutas críticas
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * @enum MetricaLatencia
+ * @brief Operaciones instrumentadas con histograma de latencia
+ */
+enum MetricaLatencia {
+    LATENCIA_PARSEO = 0,       ///< Separación de la trama "TIPO:ID:VALOR"
+    LATENCIA_BUSQUEDA,         ///< ListaGestion::buscarPorId
+    LATENCIA_CREACION,         ///< Creación de un sensor nuevo
+    LATENCIA_AGREGAR_LECTURA,  ///< agregarLectura del sensor
+    LATENCIA_PROCESAMIENTO,    ///< ListaGestion::procesarTodosSensores
+    LATENCIA_REORDEN,          ///< Espera de una lectura en ReordenadorLecturas
+    NUM_LATENCIAS
+};
+
+/**
+ * @enum MetricaContador
+ * @brief Contadores de eventos
+ */
+enum MetricaContador {
+    CONTADOR_TRAMAS = 0,        ///< Tramas recibidas
+    CONTADOR_TRAMAS_INVALIDAS,  ///< Tramas con tipo desconocido
+    CONTADOR_SENSORES_CREADOS,  ///< Sensores creados automáticamente
+    CONTADOR_SENSORES_DESALOJADOS,  ///< Sensores quitados por inactividad o presupuesto
+    CONTADOR_SENSORES_RECARGADOS,   ///< Sensores desalojados recuperados del disco
+    CONTADOR_LECTURAS_TARDIAS,      ///< Lecturas fuera de orden descartadas (fuera de la ventana de inserción)
+    CONTADOR_TRAMAS_DUPLICADAS,     ///< Retransmisiones descartadas (misma marca y valor)
+    CONTADOR_LECTURAS_INSERTADAS,   ///< Lecturas fuera de orden insertadas en su lugar del historial
+    NUM_CONTADORES
+};
+
+/**
+ * @struct BloqueMetricasHilo
+ * @brief Contadores propios de un hilo
+ *
+ * Solo el hilo dueño escribe en su bloque, por lo que las actualizaciones
+ * no requieren candados ni instrucciones atómicas de lectura-modificación;
+ * los atómicos relajados solo garantizan lecturas consistentes al exportar.
+ *
+ * Las cubetas siguen un esquema log-lineal tipo HDR: 8 sub-cubetas por
+ * potencia de dos (error relativo máximo de 12.5%).
+ */
+struct BloqueMetricasHilo {
+    static const int BITS_SUBCUBETA = 3;                    ///< log2 de sub-cubetas
+    static const int SUBCUBETAS = 1 << BITS_SUBCUBETA;      ///< Sub-cubetas por octava
+    static const int NUM_CUBETAS = 40 * SUBCUBETAS;         ///< Hasta ~2^40 ns
+
+    std::atomic<unsigned long long> contadores[NUM_CONTADORES];            ///< Eventos
+    std::atomic<unsigned long long> cubetas[NUM_LATENCIAS][NUM_CUBETAS];   ///< Histogramas
+    std::atomic<unsigned long long> sumaNs[NUM_LATENCIAS];                 ///< Suma de latencias
+    BloqueMetricasHilo* siguiente;                                          ///< Siguiente bloque registrado
+
+    /**
+     * @brief Constructor (todo en cero)
+     */
+    BloqueMetricasHilo() : siguiente(nullptr) {
+        for (int i = 0; i < NUM_CONTADORES; i++) {
+            contadores[i].store(0, std::memory_order_relaxed);
+        }
+        for (int m = 0; m < NUM_LATENCIAS; m++) {
+            sumaNs[m].store(0, std::memory_order_relaxed);
+            for (int c = 0; c < NUM_CUBETAS; c++) {
+                cubetas[m][c].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Calcula la cubeta de una latencia
+     * @param ns Latencia en nanosegundos
+     * @return Índice de cubeta
+     */
+    static int indiceCubeta(unsigned long long ns) {
+        if (ns < static_cast<unsigned long long>(SUBCUBETAS)) {
+            return static_cast<int>(ns);
+        }
+#if defined(__GNUC__)
+        int exponente = 63 - __builtin_clzll(ns);
+#else
+        int exponente = 0;
+        for (unsigned long long v = ns; v > 1; v >>= 1) exponente++;
+#endif
+        int indice = (exponente - BITS_SUBCUBETA + 1) * SUBCUBETAS
+                   + static_cast<int>((ns >> (exponente - BITS_SUBCUBETA)) - SUBCUBETAS);
+        return indice < NUM_CUBETAS ? indice : NUM_CUBETAS - 1;
+    }
+
+    /**
+     * @brief Límite superior (exclusivo) de una cubeta
+     * @param indice Índice de cubeta
+     * @return Latencia en nanosegundos
+     */
+    static unsigned long long limiteSuperior(int indice) {
+        if (indice < SUBCUBETAS) {
+            return static_cast<unsigned long long>(indice) + 1;
+        }
+        int grupo = indice / SUBCUBETAS;
+        unsigned long long sub = static_cast<unsigned long long>(indice % SUBCUBETAS);
+        return (SUBCUBETAS + sub + 1) << (grupo - 1);
+    }
+};
+
+/**
+ * @class Metricas
+ * @brief Punto de acceso global a las métricas de la aplicación
+ *
+ * Cada hilo registra su bloque la primera vez que mide algo (única
+ * operación con sincronización); después, registrar una medición es
+ * un par de incrementos locales.
+ */
+class Metricas {
+private:
+    /**
+     * @brief Cabeza de la lista de bloques registrados
+     */
+    static std::atomic<BloqueMetricasHilo*>& cabeza() {
+        static std::atomic<BloqueMetricasHilo*> primero(nullptr);
+        return primero;
+    }
+
+    /**
+     * @brief Bloque del hilo actual (se crea y registra al primer uso)
+     *
+     * Los bloques nunca se liberan: los totales de hilos terminados
+     * se conservan.
+     */
+    static BloqueMetricasHilo& bloqueLocal() {
+        static thread_local BloqueMetricasHilo* bloque = nullptr;
+        if (bloque == nullptr) {
+            bloque = new BloqueMetricasHilo();
+            BloqueMetricasHilo* anterior = cabeza().load(std::memory_order_relaxed);
+            do {
+                bloque->siguiente = anterior;
+            } while (!cabeza().compare_exchange_weak(anterior, bloque,
+                                                     std::memory_order_release,
+                                                     std::memory_order_relaxed));
+        }
+        return *bloque;
+    }
+
+    /**
+     * @brief Incremento sin instrucción atómica (un solo escritor)
+     */
+    static void sumar(std::atomic<unsigned long long>& celda, unsigned long long valor) {
+        celda.store(celda.load(std::memory_order_relaxed) + valor, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Histograma agregado de todos los hilos
+     */
+    struct Instantanea {
+        unsigned long long cubetas[BloqueMetricasHilo::NUM_CUBETAS];  ///< Conteo por cubeta
+        unsigned long long total;                                     ///< Número de mediciones
+        unsigned long long sumaNs;                                    ///< Suma de latencias
+    };
+
+    /**
+     * @brief Agrega los histogramas de todos los hilos
+     * @param metrica Métrica a leer
+     * @param inst Instantánea destino
+     */
+    static void leer(MetricaLatencia metrica, Instantanea& inst) {
+        inst.total = 0;
+        inst.sumaNs = 0;
+        for (int c = 0; c < BloqueMetricasHilo::NUM_CUBETAS; c++) {
+            inst.cubetas[c] = 0;
+        }
+        for (BloqueMetricasHilo* b = cabeza().load(std::memory_order_acquire);
+             b != nullptr; b = b->siguiente) {
+            for (int c = 0; c < BloqueMetricasHilo::NUM_CUBETAS; c++) {
+                unsigned long long n = b->cubetas[metrica][c].load(std::memory_order_relaxed);
+                inst.cubetas[c] += n;
+                inst.total += n;
+            }
+            inst.sumaNs += b->sumaNs[metrica].load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Percentil aproximado de un histograma
+     * @param inst Histograma agregado
+     * @param fraccion Percentil en [0, 1]
+     * @return Límite superior de la cubeta que lo contiene (ns)
+     */
+    static unsigned long long percentil(const Instantanea& inst, double fraccion) {
+        if (inst.total == 0) return 0;
+        unsigned long long objetivo = static_cast<unsigned long long>(fraccion * inst.total);
+        if (objetivo == 0) objetivo = 1;
+        unsigned long long acumulado = 0;
+        for (int c = 0; c < BloqueMetricasHilo::NUM_CUBETAS; c++) {
+            acumulado += inst.cubetas[c];
+            if (acumulado >= objetivo) {
+                return BloqueMetricasHilo::limiteSuperior(c);
+            }
+        }
+        return BloqueMetricasHilo::limiteSuperior(BloqueMetricasHilo::NUM_CUBETAS - 1);
+    }
+
+public:
+    /**
+     * @brief Interruptor global de la medición de latencias
+     * @return Referencia al indicador (true por defecto)
+     *
+     * Apagarlo evita leer el reloj en cada operación medida. Los
+     * contadores siguen activos: cuestan un incremento y otras partes
+     * del sistema (servidor, benchmarks) informan a partir de ellos.
+     */
+    static std::atomic<bool>& habilitadas() {
+        static std::atomic<bool> activo(true);
+        return activo;
+    }
+
+    /**
+     * @brief Registra una latencia
+     * @param metrica Operación medida
+     * @param ns Duración en nanosegundos
+     */
+    static void registrarLatencia(MetricaLatencia metrica, unsigned long long ns) {
+        BloqueMetricasHilo& b = bloqueLocal();
+        sumar(b.cubetas[metrica][BloqueMetricasHilo::indiceCubeta(ns)], 1);
+        sumar(b.sumaNs[metrica], ns);
+    }
+
+    /**
+     * @brief Incrementa un contador
+     * @param contador Contador a incrementar
+     * @param valor Incremento
+     */
+    static void incrementar(MetricaContador contador, unsigned long long valor = 1) {
+        sumar(bloqueLocal().contadores[contador], valor);
+    }
+
+    /**
+     * @brief Total de un contador sumando todos los hilos
+     * @param contador Contador a leer
+     * @return Valor acumulado
+     */
+    static unsigned long long leerContador(MetricaContador contador) {
+        unsigned long long total = 0;
+        for (BloqueMetricasHilo* b = cabeza().load(std::memory_order_acquire);
+             b != nullptr; b = b->siguiente) {
+            total += b->contadores[contador].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Nombre de una métrica de latencia
+     */
+    static const char* nombre(MetricaLatencia metrica) {
+        static const char* nombres[NUM_LATENCIAS] = {
+            "parseo", "busqueda", "creacion", "agregar_lectura", "procesamiento", "reorden"
+        };
+        return nombres[metrica];
+    }
+
+    /**
+     * @brief Nombre de un contador
+     */
+    static const char* nombre(MetricaContador contador) {
+        static const char* nombres[NUM_CONTADORES] = {
+            "tramas", "tramas_invalidas", "sensores_creados",
+            "sensores_desalojados", "sensores_recargados", "lecturas_tardias",
+            "tramas_duplicadas", "lecturas_insertadas"
+        };
+        return nombres[contador];
+    }
+
+    /**
+     * @brief Imprime un resumen legible de todas las métricas
+     * @param salida Flujo destino
+     */
+    static void imprimir(std::ostream& salida = std::cout) {
+        salida << "\n=== Metricas ("
+               << (habilitadas().load() ? "latencias habilitadas" : "latencias deshabilitadas")
+               << ") ===" << std::endl;
+
+        for (int c = 0; c < NUM_CONTADORES; c++) {
+            MetricaContador id = static_cast<MetricaContador>(c);
+            salida << "  " << std::left << std::setw(22) << nombre(id)
+                   << leerContador(id) << std::endl;
+        }
+
+        salida << "\n  " << std::left << std::setw(22) << "operacion"
+               << std::right << std::setw(10) << "cuenta"
+               << std::setw(12) << "prom(us)" << std::setw(12) << "p50(us)"
+               << std::setw(12) << "p99(us)" << std::setw(12) << "max(us)" << std::endl;
+
+        Instantanea inst;
+        std::ios::fmtflags banderas = salida.flags();
+        salida << std::fixed << std::setprecision(3);
+        for (int m = 0; m < NUM_LATENCIAS; m++) {
+            leer(static_cast<MetricaLatencia>(m), inst);
+            double promedio = inst.total ? inst.sumaNs / 1000.0 / inst.total : 0.0;
+            salida << "  " << std::left << std::setw(22) << nombre(static_cast<MetricaLatencia>(m))
+                   << std::right << std::setw(10) << inst.total
+                   << std::setw(12) << promedio
+                   << std::setw(12) << percentil(inst, 0.50) / 1000.0
+                   << std::setw(12) << percentil(inst, 0.99) / 1000.0
+                   << std::setw(12) << percentil(inst, 1.0) / 1000.0 << std::endl;
+        }
+        salida.flags(banderas);
+    }
+
+    /**
+     * @brief Escribe todas las métricas en formato de texto Prometheus
+     * @param salida Flujo destino
+     */
+    static void exportarPrometheus(std::ostream& salida) {
+        for (int c = 0; c < NUM_CONTADORES; c++) {
+            MetricaContador id = static_cast<MetricaContador>(c);
+            salida << "# TYPE sensores_iot_" << nombre(id) << "_total counter\n";
+            salida << "sensores_iot_" << nombre(id) << "_total " << leerContador(id) << "\n";
+        }
+
+        salida << "# TYPE sensores_iot_latencia_segundos histogram\n";
+        Instantanea inst;
+        char le[32];
+        for (int m = 0; m < NUM_LATENCIAS; m++) {
+            const char* op = nombre(static_cast<MetricaLatencia>(m));
+            leer(static_cast<MetricaLatencia>(m), inst);
+
+            // Una frontera por octava, hasta la última cubeta con datos
+            int ultima = BloqueMetricasHilo::SUBCUBETAS - 1;
+            for (int c = 0; c < BloqueMetricasHilo::NUM_CUBETAS; c++) {
+                if (inst.cubetas[c] != 0) ultima = c;
+            }
+            int fin = (ultima / BloqueMetricasHilo::SUBCUBETAS + 1) * BloqueMetricasHilo::SUBCUBETAS;
+            unsigned long long acumulado = 0;
+            for (int c = 0; c < fin; c++) {
+                acumulado += inst.cubetas[c];
+                if (c % BloqueMetricasHilo::SUBCUBETAS == BloqueMetricasHilo::SUBCUBETAS - 1) {
+                    snprintf(le, sizeof(le), "%g",
+                             BloqueMetricasHilo::limiteSuperior(c) / 1e9);
+                    salida << "sensores_iot_latencia_segundos_bucket{operacion=\"" << op
+                           << "\",le=\"" << le << "\"} " << acumulado << "\n";
+                }
+            }
+            salida << "sensores_iot_latencia_segundos_bucket{operacion=\"" << op
+                   << "\",le=\"+Inf\"} " << inst.total << "\n";
+            snprintf(le, sizeof(le), "%.9f", inst.sumaNs / 1e9);
+            salida << "sensores_iot_latencia_segundos_sum{operacion=\"" << op << "\"} "
+                   << le << "\n";
+            salida << "sensores_iot_latencia_segundos_count{operacion=\"" << op << "\"} "
+                   << inst.total << "\n";
+        }
+    }
+
+    /**
+     * @brief Exporta a archivo de forma atómica (escribe temporal y renombra)
+     * @param ruta Archivo destino
+     * @return true si se escribió correctamente
+     */
+    static bool exportarPrometheus(const std::string& ruta) {
+        std::string temporal = ruta + ".tmp";
+        {
+            std::ofstream archivo(temporal.c_str());
+            if (!archivo) return false;
+            exportarPrometheus(archivo);
+            if (!archivo) return false;
+        }
+        return std::rename(temporal.c_str(), ruta.c_str()) == 0;
+    }
+};
+
+/**
+ * @class CronometroMetrica
+ * @brief Mide la duración de un ámbito y la registra al destruirse (RAII)
+ */
+class CronometroMetrica {
+private:
+    MetricaLatencia metrica;                              ///< Operación medida
+    bool activo;                                          ///< Medición habilitada al iniciar
+    std::chrono::steady_clock::time_point inicio;         ///< Instante inicial
+
+public:
+    /**
+     * @brief Inicia la medición
+     * @param m Operación a medir
+     */
+    explicit CronometroMetrica(MetricaLatencia m)
+        : metrica(m), activo(Metricas::habilitadas().load(std::memory_order_relaxed)) {
+        if (activo) inicio = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Registra la duración transcurrida
+     */
+    ~CronometroMetrica() {
+        if (activo) {
+            std::chrono::nanoseconds d = std::chrono::steady_clock::now() - inicio;
+            Metricas::registrarLatencia(metrica, static_cast<unsigned long long>(d.count()));
+        }
+    }
+
+private:
+    CronometroMetrica(const CronometroMetrica&);
+    CronometroMetrica& operator=(const CronometroMetrica&);
+};
+
+/**
+ * @class ExportadorPrometheus
+ * @brief Hilo que exporta las métricas periódicamente a un archivo local
+ */
+class ExportadorPrometheus {
+private:
+    std::string ruta;                   ///< Archivo destino
+    int intervaloSeg;                   ///< Periodo de exportación
+    bool detener;                       ///< Solicitud de fin
+    std::mutex mutex;                   ///< Protege detener
+    std::condition_variable aviso;      ///< Despierta al hilo al detener
+    std::thread hilo;                   ///< Hilo exportador
+
+    /**
+     * @brief Ciclo del hilo exportador
+     */
+    void ejecutar() {
+        std::unique_lock<std::mutex> candado(mutex);
+        while (!detener) {
+            candado.unlock();
+            Metricas::exportarPrometheus(ruta);
+            candado.lock();
+            aviso.wait_for(candado, std::chrono::seconds(intervaloSeg));
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor (no inicia el hilo)
+     */
+    ExportadorPrometheus() : intervaloSeg(0), detener(true) {}
+
+    /**
+     * @brief Destructor (detiene el hilo)
+     */
+    ~ExportadorPrometheus() {
+        parar();
+    }
+
+    /**
+     * @brief Inicia (o reinicia) la exportación periódica
+     * @param archivo Ruta del archivo .prom
+     * @param segundos Periodo en segundos (mínimo 1)
+     */
+    void iniciar(const std::string& archivo, int segundos) {
+        parar();
+        ruta = archivo;
+        intervaloSeg = segundos < 1 ? 1 : segundos;
+        detener = false;
+        hilo = std::thread(&ExportadorPrometheus::ejecutar, this);
+    }
+
+    /**
+     * @brief Detiene la exportación periódica
+     */
+    void parar() {
+        {
+            std::lock_guard<std::mutex> candado(mutex);
+            detener = true;
+        }
+        aviso.notify_all();
+        if (hilo.joinable()) hilo.join();
+    }
+
+    /**
+     * @brief Indica si el hilo está activo
+     */
+    bool activo() const {
+        return hilo.joinable();
+    }
+
+    /**
+     * @brief Ruta de exportación actual
+     */
+    const std::string& getRuta() const {
+        return ruta;
+    }
+
+private:
+    ExportadorPrometheus(const ExportadorPrometheus&);
+    ExportadorPrometheus& operator=(const ExportadorPrometheus&);
+};
+
+#endif
@@ -0,0 +1,176 @@
+/**
+ * @file PoolHilos.h
+ * @brief Pool de hilos con robo de trabajo
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef POOL_HILOS_H
+#define POOL_HILOS_H
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class PoolHilos
+ * @brief Conjunto fijo de hilos que ejecutan tareas con robo de trabajo
+ *
+ * Cada hilo tiene su propia cola: toma tareas del final de la suya y,
+ * cuando se vacía, roba del frente de las colas de los demás. Las
+ * tareas se reparten en orden circular al enviarlas.
+ */
+class PoolHilos {
+private:
+    /**
+     * @struct ColaTrabajo
+     * @brief Cola de tareas de un hilo
+     */
+    struct ColaTrabajo {
+        std::mutex mutex;                             ///< Protege tareas
+        std::deque<std::function<void()> > tareas;    ///< Tareas pendientes
+    };
+
+    std::vector<ColaTrabajo*> colas;     ///< Una cola por hilo
+    std::vector<std::thread> hilos;      ///< Hilos trabajadores
+    std::atomic<std::size_t> pendientes; ///< Tareas enviadas y no terminadas
+    std::atomic<std::size_t> encoladas;  ///< Tareas en colas, aún sin tomar
+    std::atomic<std::size_t> siguiente;  ///< Cola destino del próximo envío
+    bool detener;                        ///< Solicitud de fin (protegido por mutex)
+    std::mutex mutex;                    ///< Protege detener y las esperas
+    std::condition_variable hayTrabajo;  ///< Despierta a los trabajadores
+    std::condition_variable terminado;   ///< Despierta a quien espera en esperar()
+
+    /**
+     * @brief Intenta obtener una tarea (propia primero, luego robada)
+     * @param propia Índice de la cola del hilo
+     * @param tarea Salida: tarea obtenida
+     * @return true si obtuvo una tarea
+     */
+    bool obtener(std::size_t propia, std::function<void()>& tarea) {
+        {
+            ColaTrabajo& cola = *colas[propia];
+            std::lock_guard<std::mutex> candado(cola.mutex);
+            if (!cola.tareas.empty()) {
+                tarea = std::move(cola.tareas.back());
+                cola.tareas.pop_back();
+                encoladas.fetch_sub(1);
+                return true;
+            }
+        }
+        for (std::size_t k = 1; k < colas.size(); k++) {
+            ColaTrabajo& victima = *colas[(propia + k) % colas.size()];
+            std::lock_guard<std::mutex> candado(victima.mutex);
+            if (!victima.tareas.empty()) {
+                tarea = std::move(victima.tareas.front());
+                victima.tareas.pop_front();
+                encoladas.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Ciclo de cada hilo trabajador
+     * @param propia Índice de su cola
+     */
+    void trabajar(std::size_t propia) {
+        std::function<void()> tarea;
+        while (true) {
+            if (obtener(propia, tarea)) {
+                tarea();
+                tarea = nullptr;
+                if (pendientes.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> candado(mutex);
+                    terminado.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> candado(mutex);
+            if (detener) return;
+            // Volver a revisar con el candado tomado evita perder avisos
+            hayTrabajo.wait(candado, [this] { return detener || encoladas.load() > 0; });
+            if (detener) return;
+        }
+    }
+
+    PoolHilos(const PoolHilos&);
+    PoolHilos& operator=(const PoolHilos&);
+
+public:
+    /**
+     * @brief Crea el pool e inicia los hilos
+     * @param numHilos Hilos trabajadores (0 = núcleos disponibles)
+     */
+    explicit PoolHilos(std::size_t numHilos = 0)
+        : pendientes(0), encoladas(0), siguiente(0), detener(false) {
+        if (numHilos == 0) {
+            numHilos = std::thread::hardware_concurrency();
+            if (numHilos == 0) numHilos = 1;
+        }
+        for (std::size_t i = 0; i < numHilos; i++) {
+            colas.push_back(new ColaTrabajo());
+        }
+        for (std::size_t i = 0; i < numHilos; i++) {
+            hilos.push_back(std::thread(&PoolHilos::trabajar, this, i));
+        }
+    }
+
+    /**
+     * @brief Espera las tareas pendientes y detiene los hilos
+     */
+    ~PoolHilos() {
+        esperar();
+        {
+            std::lock_guard<std::mutex> candado(mutex);
+            detener = true;
+        }
+        hayTrabajo.notify_all();
+        for (std::size_t i = 0; i < hilos.size(); i++) {
+            hilos[i].join();
+        }
+        for (std::size_t i = 0; i < colas.size(); i++) {
+            delete colas[i];
+        }
+    }
+
+    /**
+     * @brief Envía una tarea al pool
+     * @param tarea Función sin argumentos
+     */
+    void enviar(std::function<void()> tarea) {
+        pendientes.fetch_add(1);
+        encoladas.fetch_add(1);
+        ColaTrabajo& cola = *colas[siguiente.fetch_add(1) % colas.size()];
+        {
+            std::lock_guard<std::mutex> candado(cola.mutex);
+            cola.tareas.push_back(std::move(tarea));
+        }
+        std::lock_guard<std::mutex> candado(mutex);
+        hayTrabajo.notify_one();
+    }
+
+    /**
+     * @brief Bloquea hasta que todas las tareas enviadas terminen
+     */
+    void esperar() {
+        std::unique_lock<std::mutex> candado(mutex);
+        terminado.wait(candado, [this] { return pendientes.load() == 0; });
+    }
+
+    /**
+     * @brief Número de hilos trabajadores
+     */
+    std::size_t getNumHilos() const {
+        return hilos.size();
+    }
+};
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * @file Rangos.h
+ * @brief Vistas por bloques de un recorrido y reducción paralela con PoolHilos
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef RANGOS_H
+#define RANGOS_H
+
+#include "PoolHilos.h"
+#include <vector>
+#include <cstddef>
+
+const std::size_t BLOQUES_POR_HILO = 8;             ///< Bloques por hilo (el robo de trabajo equilibra)
+const std::size_t MINIMO_REDUCCION_PARALELA = 256;  ///< Elementos mínimos para repartir entre hilos
+
+/**
+ * @class Rango
+ * @brief Par de iteradores utilizable en un for de rango
+ * @tparam Iterador Iterador de avance
+ *
+ * No copia elementos: es una vista sobre un tramo del contenedor, que
+ * debe seguir vivo y sin modificarse mientras se recorre.
+ */
+template <typename Iterador>
+class Rango {
+private:
+    Iterador inicio;        ///< Primer elemento
+    Iterador fin;           ///< Uno después del último
+    std::size_t cantidad;   ///< Elementos del tramo
+
+public:
+    /**
+     * @brief Constructor
+     * @param i Primer elemento
+     * @param f Uno después del último
+     * @param n Elementos entre i y f
+     */
+    Rango(Iterador i, Iterador f, std::size_t n) : inicio(i), fin(f), cantidad(n) {}
+
+    /**
+     * @brief Primer elemento del tramo
+     */
+    Iterador begin() const { return inicio; }
+
+    /**
+     * @brief Uno después del último elemento del tramo
+     */
+    Iterador end() const { return fin; }
+
+    /**
+     * @brief Elementos del tramo
+     */
+    std::size_t size() const { return cantidad; }
+};
+
+/**
+ * @brief Parte un recorrido en bloques consecutivos de tamaño parejo
+ * @param inicio Primer elemento
+ * @param fin Uno después del último
+ * @param total Elementos entre inicio y fin (las listas lo conocen)
+ * @param numBloques Bloques deseados
+ * @return Bloques no vacíos, en orden
+ *
+ * En una lista enlazada ubicar los cortes cuesta un recorrido de
+ * punteros, mucho menos que el trabajo que luego se hace por elemento.
+ */
+template <typename Iterador>
+std::vector<Rango<Iterador> > dividirEnBloques(Iterador inicio, Iterador fin, std::size_t total,
+                                                std::size_t numBloques) {
+    std::vector<Rango<Iterador> > bloques;
+    if (total == 0) return bloques;
+    if (numBloques == 0) numBloques = 1;
+    std::size_t porBloque = (total + numBloques - 1) / numBloques;
+    bloques.reserve((total + porBloque - 1) / porBloque);
+
+    for (std::size_t hecho = 0; hecho < total; hecho += porBloque) {
+        std::size_t n = total - hecho < porBloque ? total - hecho : porBloque;
+        Iterador corte = inicio;
+        for (std::size_t i = 0; i < n; i++) {
+            ++corte;
+        }
+        bloques.push_back(Rango<Iterador>(inicio, hecho + n == total ? fin : corte, n));
+        inicio = corte;
+    }
+    return bloques;
+}
+
+/**
+ * @brief Bloques de un contenedor con begin(), end() y getCantidad()
+ * @param contenedor ListaSensor o ListaGestion
+ * @param numBloques Bloques deseados
+ * @return Bloques no vacíos, en orden
+ */
+template <typename Contenedor>
+std::vector<Rango<typename Contenedor::const_iterator> > dividirEnBloques(const Contenedor& contenedor,
+                                                                          std::size_t numBloques) {
+    return dividirEnBloques(contenedor.begin(), contenedor.end(),
+                            static_cast<std::size_t>(contenedor.getCantidad()), numBloques);
+}
+
+/**
+ * @brief Transforma cada elemento y combina los resultados, en paralelo
+ * @param pool Pool de hilos (nullptr o un solo hilo = en serie)
+ * @param contenedor ListaSensor, ListaGestion o cualquier contenedor con begin(), end() y getCantidad()
+ * @param inicial Valor inicial de la reducción
+ * @param reducir Combinación asociativa: T reducir(T, T)
+ * @param transformar T transformar(elemento)
+ * @return reducir(inicial, transformar(e1), transformar(e2), ...)
+ *
+ * Equivale a std::transform_reduce con política paralela (C++17): cada
+ * bloque se reduce en un hilo del pool y los parciales se combinan en
+ * el orden del contenedor, así que el resultado no depende del reparto
+ * si reducir es asociativa (no hace falta que sea conmutativa). El
+ * contenedor no debe modificarse mientras tanto.
+ */
+template <typename Contenedor, typename T, typename Reducir, typename Transformar>
+T reducirParalelo(PoolHilos* pool, const Contenedor& contenedor, T inicial,
+                  Reducir reducir, Transformar transformar) {
+    typedef typename Contenedor::const_iterator Iterador;
+    std::size_t total = static_cast<std::size_t>(contenedor.getCantidad());
+
+    if (pool == nullptr || pool->getNumHilos() <= 1 || total < MINIMO_REDUCCION_PARALELA) {
+        for (Iterador it = contenedor.begin(); it != contenedor.end(); ++it) {
+            inicial = reducir(inicial, transformar(*it));
+        }
+        return inicial;
+    }
+
+    std::vector<Rango<Iterador> > bloques =
+        dividirEnBloques(contenedor, pool->getNumHilos() * BLOQUES_POR_HILO);
+    std::vector<T> parciales(bloques.size(), inicial);
+
+    for (std::size_t b = 0; b < bloques.size(); b++) {
+        const Rango<Iterador>* bloque = &bloques[b];
+        T* parcial = &parciales[b];
+        const Reducir* r = &reducir;
+        const Transformar* t = &transformar;
+        pool->enviar([bloque, parcial, r, t] {
+            Iterador it = bloque->begin();
+            T acumulado = (*t)(*it);
+            for (++it; it != bloque->end(); ++it) {
+                acumulado = (*r)(acumulado, (*t)(*it));
+            }
+            *parcial = acumulado;
+        });
+    }
+    pool->esperar();
+
+    for (std::size_t b = 0; b < parciales.size(); b++) {
+        inicial = reducir(inicial, parciales[b]);
+    }
+    return inicial;
+}
+
+#endif
@@ -0,0 +1,326 @@
+/**
+ * @file RegistroSensores.h
+ * @brief Resúmenes por sensor en columnas contiguas (struct-of-arrays)
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef REGISTRO_SENSORES_H
+#define REGISTRO_SENSORES_H
+
+#include <vector>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <algorithm>
+#include "TiposSensor.h"
+
+class SensorBase;
+
+/**
+ * @struct Acumulador
+ * @brief Tipo usado para sumar lecturas sin desbordar ni perder precisión
+ * @tparam T Tipo de la lectura
+ */
+template <typename T>
+struct Acumulador {
+    typedef double tipo;  ///< Por defecto, double
+};
+
+/**
+ * @brief Las lecturas enteras se suman en 64 bits
+ */
+template <>
+struct Acumulador<int> {
+    typedef long long tipo;  ///< Suma entera exacta
+};
+
+/**
+ * @enum CampoRanking
+ * @brief Estadística por la que se ordena un ranking
+ */
+enum CampoRanking {
+    RANKING_PROMEDIO = 0,  ///< Promedio de todas las lecturas
+    RANKING_MAXIMO,        ///< Lectura máxima
+    RANKING_ULTIMO,        ///< Última lectura
+    RANKING_TASA,          ///< Tasa de cambio entre las dos últimas lecturas (por segundo)
+    NUM_CAMPOS_RANKING
+};
+
+/**
+ * @struct EntradaRanking
+ * @brief Un sensor y el valor por el que quedó en el ranking
+ */
+struct EntradaRanking {
+    SensorBase* sensor;  ///< Sensor
+    double valor;        ///< Valor de la estadística
+};
+
+/**
+ * @struct ColumnasResumen
+ * @brief Resumen de todos los sensores de un tipo, un vector por campo
+ * @tparam T Tipo de la lectura
+ *
+ * El sensor i de este tipo ocupa la posición i de cada vector, de modo
+ * que un barrido sobre un campo es un recorrido lineal de memoria
+ * contigua sin seguir punteros.
+ */
+template <typename T>
+struct ColumnasResumen {
+    typedef typename Acumulador<T>::tipo TipoSuma;  ///< Tipo de la suma
+
+    std::vector<int> cantidad;              ///< Lecturas recibidas
+    std::vector<TipoSuma> suma;             ///< Suma de lecturas
+    std::vector<T> minimo;                  ///< Lectura mínima
+    std::vector<T> maximo;                  ///< Lectura máxima
+    std::vector<T> ultimo;                  ///< Última lectura
+    std::vector<long long> marca;           ///< Marca en ms de la última lectura
+    std::vector<double> tasa;               ///< Cambio por segundo entre las dos últimas lecturas
+    std::vector<unsigned char> alerta;      ///< EstadoAlerta actual
+    std::vector<SensorBase*> sensores;      ///< Sensor dueño de cada posición
+
+    /**
+     * @brief Reserva una posición para un sensor
+     * @param sensor Sensor dueño
+     * @return Índice asignado
+     */
+    std::size_t agregar(SensorBase* sensor) {
+        cantidad.push_back(0);
+        suma.push_back(TipoSuma(0));
+        minimo.push_back(T(0));
+        maximo.push_back(T(0));
+        ultimo.push_back(T(0));
+        marca.push_back(0);
+        tasa.push_back(0.0);
+        alerta.push_back(ALERTA_NORMAL);
+        sensores.push_back(sensor);
+        return sensores.size() - 1;
+    }
+
+    /**
+     * @brief Libera una posición en O(1) moviendo allí la última
+     * @param i Índice a liberar
+     * @return Sensor que pasó a ocupar la posición i (nullptr si i era la última)
+     *
+     * El llamador debe actualizar el índice del sensor devuelto.
+     */
+    SensorBase* quitar(std::size_t i) {
+        const std::size_t ultima = sensores.size() - 1;
+        if (i != ultima) {
+            cantidad[i] = cantidad[ultima];
+            suma[i] = suma[ultima];
+            minimo[i] = minimo[ultima];
+            maximo[i] = maximo[ultima];
+            ultimo[i] = ultimo[ultima];
+            marca[i] = marca[ultima];
+            tasa[i] = tasa[ultima];
+            alerta[i] = alerta[ultima];
+            sensores[i] = sensores[ultima];
+        }
+        cantidad.pop_back();
+        suma.pop_back();
+        minimo.pop_back();
+        maximo.pop_back();
+        ultimo.pop_back();
+        marca.pop_back();
+        tasa.pop_back();
+        alerta.pop_back();
+        sensores.pop_back();
+        return i != ultima ? sensores[i] : nullptr;
+    }
+
+    /**
+     * @brief Actualiza el resumen con una lectura nueva
+     * @param i Índice del sensor
+     * @param valor Lectura
+     * @param marcaMs Marca de tiempo de la lectura
+     *
+     * La tasa solo se actualiza si el tiempo avanzó desde la lectura anterior.
+     */
+    void registrar(std::size_t i, T valor, long long marcaMs) {
+        if (cantidad[i] == 0 || valor < minimo[i]) minimo[i] = valor;
+        if (cantidad[i] == 0 || valor > maximo[i]) maximo[i] = valor;
+        if (cantidad[i] != 0 && marcaMs > marca[i]) {
+            tasa[i] = (static_cast<double>(valor) - static_cast<double>(ultimo[i]))
+                      * 1000.0 / static_cast<double>(marcaMs - marca[i]);
+        }
+        marca[i] = marcaMs;
+        ultimo[i] = valor;
+        suma[i] += valor;
+        cantidad[i]++;
+    }
+
+    /**
+     * @brief Actualiza el resumen con una lectura anterior a la última
+     * @param i Índice del sensor
+     * @param valor Lectura
+     *
+     * Cuenta para el promedio y los extremos, pero la última lectura,
+     * su marca y la tasa no cambian.
+     */
+    void registrarTardia(std::size_t i, T valor) {
+        if (cantidad[i] == 0 || valor < minimo[i]) minimo[i] = valor;
+        if (cantidad[i] == 0 || valor > maximo[i]) maximo[i] = valor;
+        suma[i] += valor;
+        cantidad[i]++;
+    }
+
+    /**
+     * @brief Promedio de las lecturas de un sensor
+     * @param i Índice del sensor
+     * @return Promedio (tipo T, 0 si no hay lecturas)
+     */
+    T promedio(std::size_t i) const {
+        if (cantidad[i] == 0) return T(0);
+        return static_cast<T>(suma[i] / cantidad[i]);
+    }
+
+    /**
+     * @brief Valor de una estadística de un sensor
+     * @param campo Estadística
+     * @param i Índice del sensor
+     */
+    double valorCampo(CampoRanking campo, std::size_t i) const {
+        switch (campo) {
+            case RANKING_MAXIMO: return static_cast<double>(maximo[i]);
+            case RANKING_ULTIMO: return static_cast<double>(ultimo[i]);
+            case RANKING_TASA:   return tasa[i];
+            default:             return static_cast<double>(suma[i]) / cantidad[i];
+        }
+    }
+
+    /**
+     * @brief Los k sensores con mayor (o menor) valor de una estadística
+     * @param campo Estadística
+     * @param k Tamaño del ranking
+     * @param mayores true = top-K, false = bottom-K
+     * @param resultado Salida: del mejor al peor (solo sensores con lecturas)
+     *
+     * Un solo barrido lineal de las columnas con un montículo de k
+     * elementos cuya raíz es el peor de los k mejores: O(n log k), sin
+     * tocar los historiales. Los empates se resuelven por posición.
+     */
+    void ranking(CampoRanking campo, std::size_t k, bool mayores,
+                 std::vector<EntradaRanking>& resultado) const {
+        typedef std::pair<double, std::size_t> Candidato;
+        resultado.clear();
+        if (k == 0) return;
+
+        // antes(a, b): a va antes que b en el ranking
+        struct Orden {
+            bool mayores;
+            bool operator()(const Candidato& a, const Candidato& b) const {
+                if (a.first != b.first) return mayores ? a.first > b.first : a.first < b.first;
+                return a.second < b.second;
+            }
+        } antes = { mayores };
+
+        std::vector<Candidato> monticulo;
+        monticulo.reserve(k);
+        const std::size_t n = sensores.size();
+        for (std::size_t i = 0; i < n; i++) {
+            if (cantidad[i] == 0) continue;
+            Candidato c(valorCampo(campo, i), i);
+            if (monticulo.size() < k) {
+                monticulo.push_back(c);
+                std::push_heap(monticulo.begin(), monticulo.end(), antes);
+            } else if (antes(c, monticulo.front())) {
+                std::pop_heap(monticulo.begin(), monticulo.end(), antes);
+                monticulo.back() = c;
+                std::push_heap(monticulo.begin(), monticulo.end(), antes);
+            }
+        }
+
+        std::sort_heap(monticulo.begin(), monticulo.end(), antes);
+        resultado.reserve(monticulo.size());
+        for (std::size_t j = 0; j < monticulo.size(); j++) {
+            EntradaRanking e = { sensores[monticulo[j].second], monticulo[j].first };
+            resultado.push_back(e);
+        }
+    }
+
+    /**
+     * @brief Número de sensores del tipo
+     */
+    std::size_t tamano() const {
+        return sensores.size();
+    }
+
+    /**
+     * @brief Cuenta sensores con lecturas y sensores en alerta (barrido lineal)
+     * @param conLecturas Salida: sensores con al menos una lectura
+     * @param enAlerta Salida: sensores en estado distinto de normal
+     */
+    void contarAlertas(std::size_t& conLecturas, std::size_t& enAlerta) const {
+        conLecturas = 0;
+        enAlerta = 0;
+        const std::size_t n = sensores.size();
+        for (std::size_t i = 0; i < n; i++) {
+            conLecturas += cantidad[i] != 0;
+            enAlerta += alerta[i] != ALERTA_NORMAL;
+        }
+    }
+
+    /**
+     * @brief Promedio de todas las lecturas del tipo (barrido lineal)
+     * @return Suma total / lecturas totales
+     */
+    double promedioGlobal() const {
+        double total = 0.0;
+        long long lecturas = 0;
+        const std::size_t n = sensores.size();
+        for (std::size_t i = 0; i < n; i++) {
+            total += static_cast<double>(suma[i]);
+            lecturas += cantidad[i];
+        }
+        return lecturas ? total / lecturas : 0.0;
+    }
+};
+
+/**
+ * @class RegistroGenerico
+ * @brief Columnas de resumen de todos los sensores, una instancia por tipo
+ * @tparam Lista Lista de rasgos de sensor (ver TiposSensor.h)
+ */
+template <typename Lista>
+class RegistroGenerico;
+
+template <typename... Ts>
+class RegistroGenerico<ListaTipos<Ts...> > {
+private:
+    std::tuple<ColumnasResumen<typename Ts::Valor>...> porTipo;  ///< Columnas de cada tipo
+
+public:
+    /**
+     * @brief Columnas del tipo descrito por Traits
+     */
+    template <typename Traits>
+    ColumnasResumen<typename Traits::Valor>& columnas() {
+        return std::get<Traits::tipo>(porTipo);
+    }
+
+    /**
+     * @brief Columnas del tipo descrito por Traits (constante)
+     */
+    template <typename Traits>
+    const ColumnasResumen<typename Traits::Valor>& columnas() const {
+        return std::get<Traits::tipo>(porTipo);
+    }
+
+    /**
+     * @brief Llama a visitante.template visitar<Traits>(columnas) para cada tipo
+     * @param visitante Objeto con un método plantilla visitar
+     */
+    template <typename Visitante>
+    void visitar(Visitante& visitante) const {
+        int expansion[] = { 0, (visitante.template visitar<Ts>(columnas<Ts>()), 0)... };
+        (void)expansion;
+    }
+};
+
+/**
+ * @brief Registro con todos los tipos de sensor de la aplicación
+ */
+typedef RegistroGenerico<TiposRegistrados> RegistroSensores;
+
+#endif
@@ -0,0 +1,396 @@
+/**
+ * @file ReordenadorLecturas.h
+ * @brief Mezcla en orden de marca las lecturas de varias fuentes con retraso acotado
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef REORDENADOR_LECTURAS_H
+#define REORDENADOR_LECTURAS_H
+
+#include "Ingesta.h"
+#include "Metricas.h"
+#include "VentanaDeslizante.h"
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * @struct LecturaPendiente
+ * @brief Trama con marca retenida hasta que sea seguro entregarla
+ */
+struct LecturaPendiente {
+    TramaSensor trama;      ///< Trama recibida (trama.marca ordena)
+    long long llegadaNs;    ///< Instante de llegada (ahoraNs), 0 = sin medir
+};
+
+/**
+ * @class ReordenadorLecturas
+ * @brief Etapa previa a ListaGestion que entrega las lecturas ordenadas por marca
+ *
+ * Cada fuente (una conexión, una pasarela, un puerto serie) tiene su
+ * cola ordenada por marca. Como una fuente casi siempre envía en orden,
+ * agregar es un push_back; si no, la lectura se inserta dentro de la
+ * cola de esa fuente, que solo guarda lo recibido dentro del retraso.
+ * Un montículo con la cabeza de cada cola hace la mezcla de k vías y
+ * otro con la marca más alta de cada fuente da la marca de agua: cada
+ * lectura cuesta O(log k) amortizado entre agregar y entregar, y una
+ * entrega que no libera nada solo mira las dos cimas.
+ *
+ * Cada fuente lleva su propia marca de agua (su marca más alta menos
+ * retrasoMs) y la cabeza mínima se entrega cuando no supera la menor de
+ * las fuentes abiertas con lecturas retenidas: una pasarela con el reloj
+ * adelantado no apura la entrega de las demás. También se entrega si
+ * lleva retrasoMs retenida (una fuente en silencio o muy atrasada no
+ * frena a las demás más que eso) o si su fuente está cerrada. La
+ * entrega se detiene en la primera cabeza que no puede salir, así que
+ * nunca sale una marca antes que otra menor retenida. La etapa no
+ * descarta nada: lo que sale detrás de otra lectura ya
+ * entregada del mismo sensor lo inserta en orden Sensor::agregarLecturaConMarca,
+ * dentro de su ventana de inserción.
+ */
+class ReordenadorLecturas {
+public:
+    static const std::size_t CAPACIDAD_POR_DEFECTO = 1 << 16;  ///< Lecturas retenidas como máximo
+
+private:
+    /**
+     * @struct Fuente
+     * @brief Cola ordenada de una fuente
+     */
+    struct Fuente {
+        std::deque<LecturaPendiente> pendientes;  ///< Lecturas retenidas, por marca
+        long long marcaMaxima;                    ///< Marca más alta recibida de esta fuente
+        unsigned int generacion;                  ///< Cambia cada vez que cambia la cabeza
+        unsigned int ciclo;                       ///< Cambia cada vez que se reutiliza el índice
+        bool abierta;                             ///< La fuente puede recibir más lecturas
+        bool enMarcas;                            ///< Tiene una entrada vigente en el montículo de marcas
+
+        Fuente() : marcaMaxima(0), generacion(0), ciclo(0), abierta(true), enMarcas(false) {}
+    };
+
+    /**
+     * @struct Cabeza
+     * @brief Entrada del montículo: cabeza de una fuente
+     *
+     * Si la cabeza cambió después de apilarla (generación distinta),
+     * la entrada está vencida y se descarta al llegar a la cima.
+     */
+    struct Cabeza {
+        long long marca;          ///< Marca de la cabeza
+        unsigned int fuente;      ///< Índice de la fuente
+        unsigned int generacion;  ///< Generación de la fuente al apilar
+    };
+
+    /**
+     * @struct OrdenCabeza
+     * @brief Comparador para un montículo de mínimos (empate: menor fuente)
+     */
+    struct OrdenCabeza {
+        bool operator()(const Cabeza& a, const Cabeza& b) const {
+            return a.marca > b.marca || (a.marca == b.marca && a.fuente > b.fuente);
+        }
+    };
+
+    /**
+     * @struct MarcaFuente
+     * @brief Entrada del montículo de marcas de agua: marca más alta de una fuente
+     *
+     * La marca puede quedar atrasada respecto de Fuente::marcaMaxima
+     * (solo crece); se corrige al llegar a la cima. La entrada de una
+     * fuente vaciada o cerrada (o de otro ciclo) se descarta ahí mismo.
+     */
+    struct MarcaFuente {
+        long long marca;      ///< Marca más alta de la fuente al apilar
+        unsigned int fuente;  ///< Índice de la fuente
+        unsigned int ciclo;   ///< Ciclo de la fuente al apilar
+    };
+
+    /**
+     * @struct OrdenMarca
+     * @brief Comparador para un montículo de mínimos de MarcaFuente
+     */
+    struct OrdenMarca {
+        bool operator()(const MarcaFuente& a, const MarcaFuente& b) const {
+            return a.marca > b.marca;
+        }
+    };
+
+    /**
+     * @struct MenorMarca
+     * @brief Compara una marca con la de una lectura (para upper_bound)
+     */
+    struct MenorMarca {
+        bool operator()(long long marca, const LecturaPendiente& lectura) const {
+            return marca < lectura.trama.marca;
+        }
+    };
+
+    std::vector<Fuente> fuentes;           ///< Fuentes, por índice
+    std::vector<unsigned int> libres;      ///< Índices de fuentes cerradas y vacías
+    std::vector<Cabeza> monticulo;         ///< Cabezas de las fuentes con lecturas
+    std::vector<MarcaFuente> marcas;       ///< Marca más alta de las fuentes abiertas con lecturas
+    long long retrasoMs;                   ///< Desorden tolerado
+    std::size_t capacidad;                 ///< Máximo de lecturas retenidas
+    std::size_t pendientes;                ///< Lecturas retenidas ahora
+    long long marcaMaxima;                 ///< Marca más alta recibida de todas las fuentes
+    unsigned long long recibidas;          ///< Lecturas recibidas
+    unsigned long long entregadas;         ///< Lecturas entregadas
+
+    /**
+     * @brief Apila la cabeza actual de una fuente
+     * @param indice Fuente con lecturas
+     */
+    void apilarCabeza(unsigned int indice) {
+        Fuente& fuente = fuentes[indice];
+        fuente.generacion++;
+        Cabeza cabeza;
+        cabeza.marca = fuente.pendientes.front().trama.marca;
+        cabeza.fuente = indice;
+        cabeza.generacion = fuente.generacion;
+        monticulo.push_back(cabeza);
+        std::push_heap(monticulo.begin(), monticulo.end(), OrdenCabeza());
+    }
+
+    /**
+     * @brief Apila la marca más alta de una fuente en el montículo de marcas
+     * @param indice Fuente abierta con lecturas
+     */
+    void apilarMarca(unsigned int indice) {
+        Fuente& fuente = fuentes[indice];
+        fuente.enMarcas = true;
+        MarcaFuente entrada;
+        entrada.marca = fuente.marcaMaxima;
+        entrada.fuente = indice;
+        entrada.ciclo = fuente.ciclo;
+        marcas.push_back(entrada);
+        std::push_heap(marcas.begin(), marcas.end(), OrdenMarca());
+    }
+
+    /**
+     * @brief Menor marca de agua de las fuentes abiertas con lecturas retenidas
+     * @return Marca hasta la que se puede entregar
+     *
+     * Cada entrada vencida o atrasada se corrige una vez por cambio de
+     * su fuente, así que el costo es O(log k) amortizado por lectura.
+     */
+    long long marcaDeAgua() {
+        while (!marcas.empty()) {
+            MarcaFuente cima = marcas.front();
+            Fuente& fuente = fuentes[cima.fuente];
+            bool vigente = cima.ciclo == fuente.ciclo;
+            if (vigente && fuente.abierta && !fuente.pendientes.empty()
+                && cima.marca == fuente.marcaMaxima) {
+                return cima.marca - retrasoMs;
+            }
+            std::pop_heap(marcas.begin(), marcas.end(), OrdenMarca());
+            marcas.pop_back();
+            if (!vigente) continue;
+            fuente.enMarcas = false;
+            if (fuente.abierta && !fuente.pendientes.empty()) apilarMarca(cima.fuente);
+        }
+        return marcaMaxima - retrasoMs;
+    }
+
+    /**
+     * @brief Entrega lecturas en orden de marca
+     * @param destino Función o lambda que recibe const LecturaPendiente&
+     * @param todas true = vaciar sin mirar las marcas de agua
+     * @return Lecturas entregadas
+     *
+     * Se detiene en la primera cabeza que no se puede entregar: las
+     * demás tienen marca mayor y saldrían antes que ella. Cada llamada
+     * cuesta O(log k) por lectura entregada más las entradas vencidas
+     * que descarta (cada una se apiló antes, con su propio costo).
+     */
+    template <typename F>
+    std::size_t entregar(F& destino, bool todas) {
+        bool medir = Metricas::habilitadas().load(std::memory_order_relaxed);
+        long long ahora = ahoraNs();
+        long long esperaNs = retrasoMs * 1000000LL;
+        long long limite = marcaDeAgua();
+        std::size_t n = 0;
+
+        while (!monticulo.empty()) {
+            Cabeza cabeza = monticulo.front();
+            Fuente& fuente = fuentes[cabeza.fuente];
+            if (cabeza.generacion == fuente.generacion) {
+                long long llegadaNs = fuente.pendientes.front().llegadaNs;
+                bool lista = todas || pendientes > capacidad || !fuente.abierta
+                    || cabeza.marca <= limite
+                    || (llegadaNs > 0 && ahora - llegadaNs >= esperaNs);
+                if (!lista) break;
+            }
+            std::pop_heap(monticulo.begin(), monticulo.end(), OrdenCabeza());
+            monticulo.pop_back();
+            if (cabeza.generacion != fuente.generacion) continue;
+
+            LecturaPendiente lectura = fuente.pendientes.front();
+            fuente.pendientes.pop_front();
+            pendientes--;
+            if (!fuente.pendientes.empty()) {
+                apilarCabeza(cabeza.fuente);
+            } else {
+                fuente.generacion++;
+                if (!fuente.abierta) libres.push_back(cabeza.fuente);
+            }
+
+            entregadas++;
+            n++;
+            if (medir && lectura.llegadaNs > 0 && ahora > lectura.llegadaNs) {
+                Metricas::registrarLatencia(LATENCIA_REORDEN,
+                                            static_cast<unsigned long long>(ahora - lectura.llegadaNs));
+            }
+            destino(lectura);
+        }
+        return n;
+    }
+
+    ReordenadorLecturas(const ReordenadorLecturas&);
+    ReordenadorLecturas& operator=(const ReordenadorLecturas&);
+
+public:
+    /**
+     * @brief Constructor
+     * @param retraso Desorden tolerado en ms
+     * @param maximo Máximo de lecturas retenidas (al superarlo se entregan las más viejas)
+     */
+    explicit ReordenadorLecturas(long long retraso = 500, std::size_t maximo = CAPACIDAD_POR_DEFECTO)
+        : retrasoMs(retraso), capacidad(maximo), pendientes(0), marcaMaxima(0),
+          recibidas(0), entregadas(0) {}
+
+    /**
+     * @brief Cambia el retraso tolerado y la capacidad
+     * @param retraso Desorden tolerado en ms
+     * @param maximo Máximo de lecturas retenidas
+     */
+    void configurar(long long retraso, std::size_t maximo = CAPACIDAD_POR_DEFECTO) {
+        retrasoMs = retraso;
+        capacidad = maximo;
+    }
+
+    /**
+     * @brief Registra una fuente nueva (reutiliza índices de fuentes ya vaciadas)
+     * @return Índice de la fuente
+     */
+    unsigned int abrirFuente() {
+        if (!libres.empty()) {
+            unsigned int indice = libres.back();
+            libres.pop_back();
+            fuentes[indice].abierta = true;
+            fuentes[indice].marcaMaxima = 0;
+            fuentes[indice].ciclo++;
+            fuentes[indice].enMarcas = false;
+            return indice;
+        }
+        fuentes.push_back(Fuente());
+        return static_cast<unsigned int>(fuentes.size() - 1);
+    }
+
+    /**
+     * @brief Indica que una fuente no enviará más lecturas
+     * @param indice Fuente
+     *
+     * Sus lecturas retenidas ya no esperan más lecturas y salen en la
+     * próxima entrega; el índice se reutiliza cuando se vacía.
+     */
+    void cerrarFuente(unsigned int indice) {
+        fuentes[indice].abierta = false;
+        if (fuentes[indice].pendientes.empty()) libres.push_back(indice);
+    }
+
+    /**
+     * @brief Recibe una trama con marca
+     * @param indice Fuente de la trama
+     * @param trama Trama con trama.marca
+     * @param llegadaNs Instante de llegada (ahoraNs) para liberarla tras
+     *        retrasoMs aunque la fuente calle y para medir la espera (0 = no)
+     */
+    void agregar(unsigned int indice, const TramaSensor& trama, long long llegadaNs = 0) {
+        Fuente& fuente = fuentes[indice];
+        if (trama.marca > fuente.marcaMaxima) fuente.marcaMaxima = trama.marca;
+        if (trama.marca > marcaMaxima) marcaMaxima = trama.marca;
+
+        LecturaPendiente lectura;
+        lectura.trama = trama;
+        lectura.llegadaNs = llegadaNs;
+
+        std::deque<LecturaPendiente>& cola = fuente.pendientes;
+        if (cola.empty() || cola.back().trama.marca <= trama.marca) {
+            cola.push_back(lectura);
+            if (cola.size() == 1) apilarCabeza(indice);
+        } else {
+            // Desorden dentro de la fuente: solo se recorre lo retenido de ella
+            std::deque<LecturaPendiente>::iterator pos =
+                std::upper_bound(cola.begin(), cola.end(), trama.marca, MenorMarca());
+            bool nuevaCabeza = pos == cola.begin();
+            cola.insert(pos, lectura);
+            if (nuevaCabeza) apilarCabeza(indice);
+        }
+        if (!fuente.enMarcas && fuente.abierta) apilarMarca(indice);
+        pendientes++;
+        recibidas++;
+    }
+
+    /**
+     * @brief Entrega las lecturas que ya quedaron detrás de la marca de agua de su fuente
+     * @param destino Función o lambda que recibe const LecturaPendiente&
+     * @return Lecturas entregadas
+     */
+    template <typename F>
+    std::size_t liberar(F destino) {
+        return entregar(destino, false);
+    }
+
+    /**
+     * @brief Entrega todas las lecturas retenidas, en orden
+     * @param destino Función o lambda que recibe const LecturaPendiente&
+     * @return Lecturas entregadas
+     *
+     * Para el cierre o cuando las fuentes quedan en silencio: lo que
+     * llegue después con marca menor se insertará en el historial de
+     * su sensor.
+     */
+    template <typename F>
+    std::size_t vaciar(F destino) {
+        return entregar(destino, true);
+    }
+
+    /**
+     * @brief Lecturas retenidas ahora
+     */
+    std::size_t getPendientes() const {
+        return pendientes;
+    }
+
+    /**
+     * @brief Desorden tolerado en ms
+     */
+    long long getRetrasoMs() const {
+        return retrasoMs;
+    }
+
+    /**
+     * @brief Marca más alta recibida
+     */
+    long long getMarcaMaxima() const {
+        return marcaMaxima;
+    }
+
+    /**
+     * @brief Lecturas recibidas
+     */
+    unsigned long long getRecibidas() const {
+        return recibidas;
+    }
+
+    /**
+     * @brief Lecturas entregadas
+     */
+    unsigned long long getEntregadas() const {
+        return entregadas;
+    }
+};
+
+#endif
@@ -10,6 +10,9 @@
 
 #include <iostream>
 #include <cstring>
+#include "RegistroSensores.h"
+#include "IndiceUbicacion.h"
+#include "FiltroDuplicados.h"
 
 /**
  * @class SensorBase
@@ -22,6 +25,12 @@ class SensorBase {
 protected:
     char* id;           ///< Identificador único del sensor
     char* ubicacion;    ///< Ubicación física del sensor
+    RegistroSensores* registro;  ///< Columnas de resumen (nullptr si no está en una lista)
+    std::size_t indiceResumen;   ///< Posición dentro de las columnas de su tipo
+    ResumenUbicacion* resumenUbicacion;  ///< Resumen de su ubicación (nullptr si no está indexado)
+    std::size_t posicionUbicacion;       ///< Posición en resumenUbicacion->sensores
+    FiltroDuplicados duplicados;         ///< Huellas de las últimas lecturas con marca
+    long long marcaDispositivo;          ///< Marca de dispositivo más alta agregada (solo tramas con marca)
     
 public:
     /**
@@ -29,7 +38,9 @@ public:
      * @param id Identificador del sensor
      * @param ubi Ubicación del sensor
      */
-    SensorBase(const char* id, const char* ubi) {
+    SensorBase(const char* id, const char* ubi)
+        : registro(nullptr), indiceResumen(0), resumenUbicacion(nullptr), posicionUbicacion(0),
+          marcaDispositivo(0) {
         this->id = new char[strlen(id) + 1];
         strcpy(this->id, id);
         
@@ -47,14 +58,106 @@ public:
     
     /**
      * @brief Procesa una lectura del sensor (método virtual puro)
+     * @param salida Flujo donde se escribe el resultado
      */
-    virtual void procesarLectura() = 0;
+    virtual void procesarLectura(std::ostream& salida) = 0;
+    
+    /**
+     * @brief Procesa una lectura del sensor y la muestra en consola
+     */
+    void procesarLectura() {
+        procesarLectura(std::cout);
+    }
     
     /**
      * @brief Imprime información del sensor (método virtual puro)
      */
     virtual void imprimirInfo() const = 0;
     
+    /**
+     * @brief Tipo concreto del sensor (método virtual puro)
+     * @return Tipo del sensor
+     */
+    virtual TipoSensor getTipo() const = 0;
+    
+    /**
+     * @brief Reserva la posición del sensor en las columnas de resumen
+     * @param r Registro dueño de las columnas
+     *
+     * Las clases derivadas vuelcan en el resumen las lecturas que ya
+     * tuvieran antes de ser registradas.
+     */
+    virtual void vincularRegistro(RegistroSensores* r) = 0;
+    
+    /**
+     * @brief Libera la posición del sensor en las columnas de resumen
+     *
+     * El último sensor del mismo tipo ocupa la posición liberada.
+     */
+    virtual void desvincularRegistro() = 0;
+    
+    /**
+     * @brief Etiqueta de trama del tipo ("TEMP", "PRES", ...) empaquetada
+     * @return Código de codigoEtiqueta
+     */
+    virtual unsigned int getCodigoEtiqueta() const = 0;
+    
+    /**
+     * @brief Escribe las lecturas como "valor@marca", separadas por espacios
+     * @param salida Flujo destino
+     *
+     * Cada valor se puede volver a leer con Traits::convertir.
+     */
+    virtual void guardarLecturas(std::ostream& salida) const = 0;
+    
+    /**
+     * @brief Primer nodo del historial y su longitud actual
+     * @param cantidad Salida: lecturas en el historial
+     * @return Puntero a Nodo<Valor> del tipo del sensor (ver getTipo)
+     */
+    virtual const void* getHistorial(int& cantidad) const = 0;
+    
+    /**
+     * @brief Resumen de todas sus lecturas (desde las columnas del registro)
+     * @param lecturas Salida: cantidad (0 si no está registrado)
+     * @param suma Salida: suma
+     * @param minimo Salida: mínimo
+     * @param maximo Salida: máximo
+     */
+    virtual void resumenLecturas(long long& lecturas, double& suma,
+                                 double& minimo, double& maximo) const = 0;
+    
+    /**
+     * @brief Asocia el sensor al resumen de su ubicación
+     * @param resumen Resumen que se actualizará con cada lectura (nullptr = ninguno)
+     * @param posicion Posición del sensor en resumen->sensores
+     *
+     * Debe llamarse antes de vincularRegistro para que las lecturas
+     * previas también se vuelquen en la ubicación.
+     */
+    void vincularUbicacion(ResumenUbicacion* resumen, std::size_t posicion) {
+        resumenUbicacion = resumen;
+        posicionUbicacion = posicion;
+    }
+    
+    /**
+     * @brief Resumen de su ubicación
+     * @return Puntero al resumen, o nullptr
+     */
+    ResumenUbicacion* getResumenUbicacion() const { return resumenUbicacion; }
+    
+    /**
+     * @brief Posición del sensor en su resumen de ubicación
+     */
+    std::size_t getPosicionUbicacion() const { return posicionUbicacion; }
+    
+    /**
+     * @brief Indica si una lectura con marca de dispositivo llega detrás de la más reciente
+     * @param marca Marca del dispositivo
+     * @return true si agregarla requiere insertarla dentro del historial
+     */
+    bool esTardia(long long marca) const { return marca < marcaDispositivo; }
+    
     /**
      * @brief Obtiene el ID del sensor
      * @return Puntero al identificador
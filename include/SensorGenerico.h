@@ -0,0 +1,329 @@
+/**
+ * @file SensorGenerico.h
+ * @brief Sensor concreto parametrizado por sus rasgos
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef SENSOR_GENERICO_H
+#define SENSOR_GENERICO_H
+
+#include "SensorBase.h"
+#include "ListaSensor.h"
+#include "TiposSensor.h"
+#include "SketchCuantiles.h"
+#include "VentanaDeslizante.h"
+#include "Metricas.h"
+
+/**
+ * @class Sensor
+ * @brief Sensor de un tipo concreto (temperatura, presión, vibración...)
+ * @tparam Traits Rasgos del tipo: valor, unidad, límites y mensajes
+ *
+ * Hereda de SensorBase e implementa el procesamiento común a todos
+ * los tipos; lo específico de cada uno se resuelve en tiempo de
+ * compilación a través de Traits.
+ */
+template <typename Traits>
+class Sensor : public SensorBase {
+public:
+    typedef typename Traits::Valor Valor;  ///< Tipo de lectura
+
+private:
+    ListaSensor<Valor> lecturas;  ///< Lista de lecturas
+    SketchCuantiles cuantiles;    ///< Mediana y percentiles sin recorrer la lista
+    VentanaDeslizante<Valor> ventana;  ///< Últimas lecturas (por cantidad y/o tiempo)
+    PromedioExponencial ewma;          ///< Media móvil exponencial
+
+    /**
+     * @brief Vuelca una lectura en las columnas de resumen
+     * @param valor Lectura nueva
+     * @param marcaMs Marca de tiempo de la lectura
+     * @param enOrden false si es anterior a la última (no la reemplaza)
+     */
+    void actualizarResumen(Valor valor, long long marcaMs, bool enOrden = true) {
+        ColumnasResumen<Valor>& columnas = registro->template columnas<Traits>();
+        if (enOrden) columnas.registrar(indiceResumen, valor, marcaMs);
+        else columnas.registrarTardia(indiceResumen, valor);
+        if (resumenUbicacion != nullptr) {
+            resumenUbicacion->registrar(Traits::tipo, static_cast<double>(valor));
+        }
+        columnas.alerta[indiceResumen] = static_cast<unsigned char>(
+            Traits::evaluarAlerta(columnas.promedio(indiceResumen)));
+    }
+
+    /**
+     * @brief Inserta una lectura anterior a la más reciente
+     * @param valor Lectura en la unidad del tipo
+     * @param marcaMs Marca de tiempo en ms
+     * @return false si no cabe en la ventana de inserción (se descarta)
+     */
+    bool agregarFueraDeOrden(Valor valor, long long marcaMs) {
+        if (!lecturas.insertarOrdenado(valor, marcaMs)) {
+            Metricas::incrementar(CONTADOR_LECTURAS_TARDIAS);
+            return false;
+        }
+        Metricas::incrementar(CONTADOR_LECTURAS_INSERTADAS);
+        cuantiles.agregar(static_cast<float>(valor));
+        if (registro != nullptr) {
+            actualizarResumen(valor, marcaMs, false);
+        }
+        return true;
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param id Identificador del sensor
+     * @param ubi Ubicación del sensor
+     */
+    Sensor(const char* id, const char* ubi)
+        : SensorBase(id, ubi) {}
+
+    /**
+     * @brief Agrega una lectura con la hora actual
+     * @param valor Lectura en la unidad del tipo
+     */
+    void agregarLectura(Valor valor) {
+        agregarLectura(valor, ahoraMs());
+    }
+
+    /**
+     * @brief Agrega una lectura en orden de llegada
+     * @param valor Lectura en la unidad del tipo
+     * @param marcaMs Marca de tiempo en ms (hora local, o la guardada al recargar)
+     *
+     * Costo constante sin importar el tamaño de la ventana.
+     */
+    void agregarLectura(Valor valor, long long marcaMs) {
+        lecturas.agregar(valor, marcaMs);
+        cuantiles.agregar(static_cast<float>(valor));
+        ventana.agregar(valor, marcaMs);
+        ewma.agregar(static_cast<double>(valor));
+        if (registro != nullptr) {
+            actualizarResumen(valor, marcaMs);
+        }
+    }
+
+    /**
+     * @brief Agrega una lectura con la marca que puso el dispositivo
+     * @param valor Lectura en la unidad del tipo
+     * @param marcaMs Marca del dispositivo en ms
+     * @return false si es una retransmisión o si llegó fuera de orden y
+     *         fuera de la ventana de inserción (se descarta)
+     *
+     * Una lectura con la misma marca y el mismo valor que una de las
+     * últimas aceptadas es una retransmisión: se cuenta y no se agrega.
+     * Solo se recuerda después de agregarla, así que si la original se
+     * descartó el reintento todavía puede entrar. Las marcas de dispositivo solo se comparan con las anteriores del
+     * mismo origen (marcaDispositivo), nunca con la hora local de las
+     * lecturas sin marca. En orden equivale a agregarLectura(). Una
+     * marca menor que la más reciente se inserta en su lugar del
+     * historial (ListaSensor::insertarOrdenado) y cuenta en los cuantiles
+     * y el resumen; la ventana y la EWMA siguen solo a las lecturas más
+     * recientes, así que no la reciben. Si un sensor recibe tramas con y
+     * sin marca, las sin marca quedan en orden de llegada.
+     */
+    bool agregarLecturaConMarca(Valor valor, long long marcaMs) {
+        unsigned long long huella = FiltroDuplicados::huella(marcaMs, static_cast<double>(valor));
+        if (duplicados.contiene(huella)) {
+            Metricas::incrementar(CONTADOR_TRAMAS_DUPLICADAS);
+            return false;
+        }
+        if (marcaMs < marcaDispositivo) {
+            if (!agregarFueraDeOrden(valor, marcaMs)) return false;
+        } else {
+            marcaDispositivo = marcaMs;
+            agregarLectura(valor, marcaMs);
+        }
+        duplicados.registrar(huella);
+        return true;
+    }
+
+    /**
+     * @brief Configura la ventana deslizante y la EWMA
+     * @param maxLecturas Últimas N lecturas (mínimo 1)
+     * @param duracionMs Últimos T ms respecto de la lectura más reciente (0 = sin límite)
+     * @param alfa Peso de cada lectura nueva en la EWMA, en (0, 1]
+     */
+    void configurarVentana(std::size_t maxLecturas, long long duracionMs, double alfa) {
+        ventana.configurar(maxLecturas, duracionMs);
+        ewma.setAlfa(alfa);
+    }
+
+    /**
+     * @brief Estado de alerta según el promedio de la ventana
+     * @return Estado de alerta de las lecturas recientes
+     */
+    EstadoAlerta estadoReciente() const {
+        return Traits::evaluarAlerta(ventana.promedio());
+    }
+
+    /**
+     * @brief Clasifica un promedio según los límites del tipo
+     * @param promedio Promedio a evaluar
+     * @return Estado de alerta
+     */
+    static EstadoAlerta evaluarAlerta(Valor promedio) {
+        return Traits::evaluarAlerta(promedio);
+    }
+
+    using SensorBase::procesarLectura;
+
+    /**
+     * @brief Procesa las lecturas
+     * @param salida Flujo donde se escribe el resultado
+     *
+     * Calcula promedio y verifica límites del tipo, tanto para todo el
+     * historial como para la ventana reciente. Solo lee el sensor, por
+     * lo que varios sensores pueden procesarse en paralelo.
+     */
+    void procesarLectura(std::ostream& salida) override {
+        if (lecturas.getCantidad() == 0) {
+            salida << "  No hay lecturas" << std::endl;
+            return;
+        }
+
+        // Con registro el promedio sale del resumen en O(1)
+        Valor promedio = registro != nullptr
+            ? registro->template columnas<Traits>().promedio(indiceResumen)
+            : lecturas.calcularPromedio();
+        salida << "  Promedio: " << promedio << Traits::unidad() << std::endl;
+        
+        static const double fracciones[3] = { 0.50, 0.95, 0.99 };
+        float valores[3];
+        cuantiles.cuantiles(fracciones, 3, valores);
+        salida << "  Mediana: " << static_cast<Valor>(valores[0])
+               << " | p95: " << static_cast<Valor>(valores[1])
+               << " | p99: " << static_cast<Valor>(valores[2]) << Traits::unidad() << std::endl;
+        salida << "  Ventana (" << ventana.cantidad() << "): prom " << ventana.promedio()
+               << " | min " << ventana.minimo()
+               << " | max " << ventana.maximo()
+               << " | EWMA " << static_cast<Valor>(ewma.getValor()) << Traits::unidad() << std::endl;
+        salida << "  " << Traits::mensaje(Traits::evaluarAlerta(promedio)) << std::endl;
+        salida << "  Reciente -> " << Traits::mensaje(estadoReciente()) << std::endl;
+    }
+
+    /**
+     * @brief Imprime información del sensor
+     */
+    void imprimirInfo() const override {
+        std::cout << "\n[" << Traits::nombre() << "]" << std::endl;
+        std::cout << "  ID: " << id << std::endl;
+        std::cout << "  Ubicacion: " << ubicacion << std::endl;
+        std::cout << "  Lecturas (" << lecturas.getCantidad() << "): ";
+        lecturas.imprimir();
+        std::cout << std::endl;
+    }
+
+    /**
+     * @brief Tipo concreto del sensor
+     * @return Traits::tipo
+     */
+    TipoSensor getTipo() const override {
+        return Traits::tipo;
+    }
+
+    /**
+     * @brief Reserva su posición en el registro y vuelca sus lecturas previas
+     * @param r Registro dueño de las columnas
+     */
+    void vincularRegistro(RegistroSensores* r) override {
+        registro = r;
+        indiceResumen = r->template columnas<Traits>().agregar(this);
+        lecturas.recorrerConMarca([this](Valor valor, long long marcaMs) {
+            actualizarResumen(valor, marcaMs);
+        });
+    }
+
+    /**
+     * @brief Libera su posición en el registro (la ocupa el último de su tipo)
+     */
+    void desvincularRegistro() override {
+        if (registro == nullptr) return;
+        SensorBase* movido = registro->template columnas<Traits>().quitar(indiceResumen);
+        if (movido != nullptr) {
+            static_cast<Sensor*>(movido)->indiceResumen = indiceResumen;
+        }
+        registro = nullptr;
+        indiceResumen = 0;
+    }
+
+    /**
+     * @brief Resumen de todas sus lecturas (desde las columnas del registro)
+     */
+    void resumenLecturas(long long& n, double& suma, double& minimo, double& maximo) const override {
+        n = 0;
+        suma = minimo = maximo = 0.0;
+        if (registro == nullptr) return;
+        const ColumnasResumen<Valor>& columnas = registro->template columnas<Traits>();
+        n = columnas.cantidad[indiceResumen];
+        suma = static_cast<double>(columnas.suma[indiceResumen]);
+        minimo = static_cast<double>(columnas.minimo[indiceResumen]);
+        maximo = static_cast<double>(columnas.maximo[indiceResumen]);
+    }
+
+    /**
+     * @brief Etiqueta de trama del tipo
+     * @return Traits::codigo
+     */
+    unsigned int getCodigoEtiqueta() const override {
+        return Traits::codigo;
+    }
+
+    /**
+     * @brief Escribe las lecturas como "valor@marca", separadas por espacios
+     * @param salida Flujo destino
+     */
+    void guardarLecturas(std::ostream& salida) const override {
+        std::streamsize precision = salida.precision(9);
+        lecturas.recorrerConMarca([&salida](Valor valor, long long marcaMs) {
+            salida << valor << '@' << marcaMs << ' ';
+        });
+        salida.precision(precision);
+    }
+
+    /**
+     * @brief Primer nodo del historial y su longitud actual
+     * @param cantidad Salida: lecturas en el historial
+     * @return Nodo<Valor>* como puntero genérico
+     */
+    const void* getHistorial(int& cantidad) const override {
+        cantidad = lecturas.getCantidad();
+        return lecturas.getCabeza();
+    }
+
+    /**
+     * @brief Obtiene el sketch de cuantiles
+     * @return Referencia al sketch
+     */
+    const SketchCuantiles& getCuantiles() const {
+        return cuantiles;
+    }
+
+    /**
+     * @brief Obtiene la ventana deslizante
+     * @return Referencia a la ventana
+     */
+    const VentanaDeslizante<Valor>& getVentana() const {
+        return ventana;
+    }
+
+    /**
+     * @brief Obtiene la media móvil exponencial
+     * @return Referencia a la EWMA
+     */
+    const PromedioExponencial& getEwma() const {
+        return ewma;
+    }
+
+    /**
+     * @brief Obtiene la lista de lecturas
+     * @return Referencia a la lista
+     */
+    const ListaSensor<Valor>& getLecturas() const {
+        return lecturas;
+    }
+};
+
+#endif
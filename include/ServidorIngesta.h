@@ -0,0 +1,654 @@
+/**
+ * @file ServidorIngesta.h
+ * @brief Servidor TCP/UDP con epoll que recibe tramas de varias pasarelas
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef SERVIDOR_INGESTA_H
+#define SERVIDOR_INGESTA_H
+
+#include "Ingesta.h"
+#include "ReordenadorLecturas.h"
+#include "ListaGestion.h"
+#include "Metricas.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#include <cstring>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <unordered_set>
+
+/**
+ * @class ServidorIngesta
+ * @brief Recibe tramas "TIPO:ID:VALOR\n" por TCP y UDP y las agrega a ListaGestion
+ *
+ * Un solo hilo atiende todos los sockets con epoll en modo
+ * edge-triggered: ante cada aviso lee hasta EAGAIN, acumula los bytes
+ * en el buffer de la conexión y procesa de una vez todas las tramas
+ * completas; lo que queda a medias espera al siguiente aviso. Como el
+ * hilo del servidor es el único que toca la lista mientras corre, no
+ * hace falta sincronizar ListaGestion.
+ *
+ * La trama "PING:<dato>" se responde con "PONG:<dato>\n" por el mismo
+ * canal, después de procesar las tramas anteriores de esa conexión: el
+ * cliente mide así la latencia de extremo a extremo. Con reordenamiento,
+ * las tramas con marca anteriores pueden seguir retenidas al responder
+ * (no se adelanta su entrega por un PING). Las respuestas pendientes
+ * de una conexión se limitan a CAPACIDAD_SALIDA; si el cliente no las
+ * lee y se llega al límite, la conexión se cierra.
+ *
+ * Cuando el cliente cierra, la última trama se procesa aunque no
+ * termine en '\n'.
+ *
+ * Con configurarReorden, las tramas que traen marca pasan por un
+ * ReordenadorLecturas donde cada conexión (y el socket UDP) es una
+ * fuente; se entregan a la lista al final de cada lote de eventos, o
+ * todas juntas si no llega nada durante el retraso tolerado.
+ */
+class ServidorIngesta {
+public:
+    static const std::size_t CAPACIDAD_ENTRADA = 8192;  ///< Buffer de lectura por conexión
+    static const std::size_t CAPACIDAD_SALIDA = 65536;  ///< Respuestas pendientes por conexión
+    static const int MAX_EVENTOS = 256;                 ///< Eventos por llamada a epoll_wait
+    static const int ESPERA_MAXIMA_MS = 60000;          ///< Silencio máximo antes de vaciar el reordenador
+
+private:
+    /**
+     * @enum TipoCanal
+     * @brief Qué representa cada descriptor registrado en epoll
+     */
+    enum TipoCanal { CANAL_ESCUCHA, CANAL_UDP, CANAL_AVISO, CANAL_CONEXION };
+
+    /**
+     * @struct Canal
+     * @brief Descriptor registrado en epoll y su estado
+     */
+    struct Canal {
+        int fd;                              ///< Descriptor
+        TipoCanal tipo;                      ///< Rol del descriptor
+        char entrada[CAPACIDAD_ENTRADA];     ///< Bytes recibidos aún sin procesar
+        std::size_t usados;                  ///< Bytes válidos en entrada
+        bool descartando;                    ///< Descartando una línea demasiado larga
+        std::string salida;                  ///< Respuestas pendientes de enviar
+        unsigned int fuente;                 ///< Fuente en el reordenador
+
+        Canal(int f, TipoCanal t) : fd(f), tipo(t), usados(0), descartando(false), fuente(0) {}
+    };
+
+    ListaGestion& lista;                 ///< Destino de las lecturas
+    int epollFd;                         ///< Instancia de epoll
+    Canal* escucha;                      ///< Socket TCP de escucha
+    Canal* udp;                          ///< Socket UDP
+    Canal* aviso;                        ///< eventfd para detener el ciclo
+    int reserva;                         ///< Descriptor de reserva para rechazar conexiones sin descriptores libres
+    std::unordered_set<Canal*> conexiones;  ///< Conexiones TCP abiertas
+    std::thread hilo;                    ///< Hilo del ciclo de eventos
+    std::atomic<bool> corriendo;         ///< El ciclo está activo
+    std::atomic<unsigned long long> tramas;       ///< Tramas procesadas
+    std::atomic<unsigned long long> bytes;        ///< Bytes recibidos
+    std::atomic<unsigned long long> aceptadas;    ///< Conexiones aceptadas
+    std::atomic<unsigned long long> rechazadas;   ///< Conexiones cerradas al aceptarlas por falta de descriptores
+    std::atomic<std::size_t> abiertas;            ///< Conexiones abiertas ahora
+    unsigned short puertoTcp;            ///< Puerto TCP asignado
+    unsigned short puertoUdp;            ///< Puerto UDP asignado
+    ReordenadorLecturas reordenador;     ///< Orden por marca entre conexiones
+    bool reordenar;                      ///< Las tramas con marca pasan por el reordenador
+
+    /**
+     * @struct IngerirReordenada
+     * @brief Destino de ReordenadorLecturas: agrega la lectura con su marca de origen
+     */
+    struct IngerirReordenada {
+        ListaGestion& lista;  ///< Lista destino
+
+        explicit IngerirReordenada(ListaGestion& l) : lista(l) {}
+
+        void operator()(const LecturaPendiente& lectura) const {
+            ingerirTrama(lista, lectura.trama, "Pasarela", lectura.trama.marca);
+        }
+    };
+
+    ServidorIngesta(const ServidorIngesta&);
+    ServidorIngesta& operator=(const ServidorIngesta&);
+
+    /**
+     * @brief Crea un socket no bloqueante ligado a 127.0.0.1
+     * @param tipo SOCK_STREAM o SOCK_DGRAM
+     * @param puerto Puerto pedido (0 = cualquiera libre)
+     * @param asignado Salida: puerto real
+     * @return Descriptor, o -1 si falla
+     */
+    static int abrirSocket(int tipo, unsigned short puerto, unsigned short& asignado) {
+        int fd = socket(AF_INET, tipo | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) return -1;
+
+        int uno = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &uno, sizeof(uno));
+
+        sockaddr_in direccion;
+        std::memset(&direccion, 0, sizeof(direccion));
+        direccion.sin_family = AF_INET;
+        direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        direccion.sin_port = htons(puerto);
+        if (bind(fd, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0
+            || (tipo == SOCK_STREAM && listen(fd, SOMAXCONN) < 0)) {
+            close(fd);
+            return -1;
+        }
+
+        socklen_t largo = sizeof(direccion);
+        getsockname(fd, reinterpret_cast<sockaddr*>(&direccion), &largo);
+        asignado = ntohs(direccion.sin_port);
+        return fd;
+    }
+
+    /**
+     * @brief Registra un canal en epoll
+     * @param canal Canal a registrar
+     * @param eventos Máscara de eventos
+     * @return true si se registró
+     */
+    bool registrar(Canal* canal, unsigned int eventos) {
+        epoll_event ev;
+        std::memset(&ev, 0, sizeof(ev));
+        ev.events = eventos;
+        ev.data.ptr = canal;
+        return epoll_ctl(epollFd, EPOLL_CTL_ADD, canal->fd, &ev) == 0;
+    }
+
+    /**
+     * @brief Procesa una trama completa (sin el salto de línea)
+     * @param texto Inicio de la trama
+     * @param longitud Bytes de la trama
+     * @param canal Canal por el que llegó
+     * @param respuesta Salida: se le agrega el PONG si la trama es un PING
+     * @param marcaMs Marca de tiempo del lote
+     *
+     * Si respuesta ya tiene CAPACIDAD_SALIDA bytes (el cliente no lee
+     * sus PONG) el PING se descarta; el ciclo cierra esa conexión.
+     */
+    void procesarLinea(const char* texto, std::size_t longitud, const Canal* canal,
+                       std::string& respuesta, long long marcaMs) {
+        if (longitud == 0 || (longitud == 1 && texto[0] == '\r')) return;
+
+        if (longitud >= 5 && std::memcmp(texto, "PING:", 5) == 0) {
+            if (respuesta.size() >= CAPACIDAD_SALIDA) return;
+            respuesta.append("PONG:", 5);
+            respuesta.append(texto + 5, longitud - 5);
+            respuesta.push_back('\n');
+            return;
+        }
+
+        Metricas::incrementar(CONTADOR_TRAMAS);
+        tramas.fetch_add(1, std::memory_order_relaxed);
+        TramaSensor trama;
+        if (!parsearTrama(texto, longitud, trama)) {
+            Metricas::incrementar(CONTADOR_TRAMAS_INVALIDAS);
+        } else if (trama.marca == 0) {
+            ingerirTrama(lista, trama, "Pasarela", marcaMs);
+        } else if (reordenar) {
+            reordenador.agregar(canal->fuente, trama, ahoraNs());
+        } else {
+            ingerirTrama(lista, trama, "Pasarela", trama.marca);
+        }
+    }
+
+    /**
+     * @brief Pasa a la lista las lecturas que el reordenador ya liberó
+     * @param todas true = también las retenidas (cierre o silencio)
+     */
+    void entregarReordenadas(bool todas) {
+        if (!reordenar || reordenador.getPendientes() == 0) return;
+        IngerirReordenada ingerir(lista);
+        if (todas) {
+            reordenador.vaciar(ingerir);
+        } else {
+            reordenador.liberar(ingerir);
+        }
+    }
+
+    /**
+     * @brief Procesa todas las tramas completas del buffer de una conexión
+     * @param canal Conexión
+     * @param marcaMs Marca de tiempo del lote
+     *
+     * Lo que queda después del último '\n' se mueve al inicio del
+     * buffer. Una línea que llena el buffer sin terminar se descarta
+     * completa y cuenta como trama inválida.
+     */
+    void procesarBuffer(Canal* canal, long long marcaMs) {
+        const char* inicio = canal->entrada;
+        const char* fin = canal->entrada + canal->usados;
+
+        while (inicio < fin) {
+            const char* salto = static_cast<const char*>(std::memchr(inicio, '\n', fin - inicio));
+            if (salto == nullptr) break;
+            if (canal->descartando) {
+                canal->descartando = false;
+            } else {
+                procesarLinea(inicio, salto - inicio, canal, canal->salida, marcaMs);
+            }
+            inicio = salto + 1;
+        }
+
+        std::size_t resto = fin - inicio;
+        if (resto == CAPACIDAD_ENTRADA) {
+            if (!canal->descartando) {
+                Metricas::incrementar(CONTADOR_TRAMAS);
+                Metricas::incrementar(CONTADOR_TRAMAS_INVALIDAS);
+            }
+            canal->descartando = true;
+            resto = 0;
+        } else if (resto > 0 && inicio != canal->entrada) {
+            std::memmove(canal->entrada, inicio, resto);
+        }
+        canal->usados = resto;
+    }
+
+    /**
+     * @brief Al cerrar el cliente, procesa la última trama aunque no termine en '\n'
+     * @param canal Conexión
+     * @param marcaMs Marca de tiempo del lote
+     */
+    void procesarResto(Canal* canal, long long marcaMs) {
+        if (canal->usados > 0 && !canal->descartando) {
+            procesarLinea(canal->entrada, canal->usados, canal, canal->salida, marcaMs);
+        }
+        canal->usados = 0;
+        canal->descartando = false;
+    }
+
+    /**
+     * @brief Cuenta como trama inválida lo que quedó a medias en una conexión fallida
+     * @param canal Conexión
+     */
+    void descartarResto(Canal* canal) {
+        if (canal->usados > 0 && !canal->descartando) {
+            Metricas::incrementar(CONTADOR_TRAMAS);
+            Metricas::incrementar(CONTADOR_TRAMAS_INVALIDAS);
+        }
+        canal->usados = 0;
+        canal->descartando = false;
+    }
+
+    /**
+     * @brief Intenta enviar las respuestas pendientes de una conexión
+     * @param canal Conexión
+     * @return false si la conexión falló
+     */
+    bool vaciarSalida(Canal* canal) {
+        std::size_t enviados = 0;
+        while (enviados < canal->salida.size()) {
+            ssize_t n = send(canal->fd, canal->salida.data() + enviados,
+                             canal->salida.size() - enviados, MSG_NOSIGNAL);
+            if (n > 0) {
+                enviados += static_cast<std::size_t>(n);
+            } else if (n < 0 && errno == EINTR) {
+                continue;
+            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;  // Se reintenta con EPOLLOUT
+            } else {
+                return false;
+            }
+        }
+        canal->salida.erase(0, enviados);
+        return true;
+    }
+
+    /**
+     * @brief Cierra y libera una conexión
+     * @param canal Conexión
+     */
+    void cerrar(Canal* canal) {
+        reordenador.cerrarFuente(canal->fuente);
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, canal->fd, nullptr);
+        close(canal->fd);
+        conexiones.erase(canal);
+        abiertas.fetch_sub(1, std::memory_order_relaxed);
+        delete canal;
+    }
+
+    /**
+     * @brief Acepta todas las conexiones pendientes
+     *
+     * La escucha es edge-triggered: si se sale con conexiones en la cola
+     * no llega otro aviso hasta que conecte alguien más. Por eso, sin
+     * descriptores libres (EMFILE/ENFILE), se suelta el de reserva para
+     * aceptar y cerrar la conexión y se sigue hasta EAGAIN.
+     */
+    void aceptar() {
+        while (true) {
+            int fd = accept4(escucha->fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) continue;
+                if ((errno == EMFILE || errno == ENFILE) && reserva >= 0) {
+                    close(reserva);
+                    int rechazada = accept4(escucha->fd, nullptr, nullptr, SOCK_CLOEXEC);
+                    if (rechazada >= 0) close(rechazada);
+                    reserva = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                    if (rechazada >= 0) {
+                        rechazadas.fetch_add(1, std::memory_order_relaxed);
+                        continue;
+                    }
+                }
+                break;  // EAGAIN
+            }
+            int uno = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+
+            Canal* canal = new Canal(fd, CANAL_CONEXION);
+            if (!registrar(canal, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET)) {
+                close(fd);
+                delete canal;
+                continue;
+            }
+            canal->fuente = reordenador.abrirFuente();
+            conexiones.insert(canal);
+            aceptadas.fetch_add(1, std::memory_order_relaxed);
+            abiertas.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Lee una conexión hasta EAGAIN y procesa lo recibido
+     * @param canal Conexión
+     * @return false si la conexión se cerró o falló
+     */
+    bool leerConexion(Canal* canal) {
+        long long marcaMs = ahoraMs();
+        while (true) {
+            ssize_t n = recv(canal->fd, canal->entrada + canal->usados,
+                             CAPACIDAD_ENTRADA - canal->usados, 0);
+            if (n > 0) {
+                bytes.fetch_add(static_cast<unsigned long long>(n), std::memory_order_relaxed);
+                canal->usados += static_cast<std::size_t>(n);
+                if (canal->usados == CAPACIDAD_ENTRADA) {
+                    procesarBuffer(canal, marcaMs);
+                }
+            } else if (n == 0) {
+                procesarBuffer(canal, marcaMs);
+                procesarResto(canal, marcaMs);
+                return false;
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                procesarBuffer(canal, marcaMs);
+                return true;
+            } else {
+                descartarResto(canal);
+                return false;
+            }
+        }
+    }
+
+    /**
+     * @brief Lee todos los datagramas pendientes
+     *
+     * Cada datagrama puede traer varias tramas separadas por '\n'; la
+     * última no necesita salto de línea.
+     */
+    void leerUdp() {
+        char datagrama[65536];
+        long long marcaMs = ahoraMs();
+        std::string respuesta;
+        while (true) {
+            sockaddr_in origen;
+            socklen_t largo = sizeof(origen);
+            ssize_t n = recvfrom(udp->fd, datagrama, sizeof(datagrama), 0,
+                                 reinterpret_cast<sockaddr*>(&origen), &largo);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            bytes.fetch_add(static_cast<unsigned long long>(n), std::memory_order_relaxed);
+
+            const char* inicio = datagrama;
+            const char* fin = datagrama + n;
+            while (inicio < fin) {
+                const char* salto = static_cast<const char*>(std::memchr(inicio, '\n', fin - inicio));
+                const char* finLinea = salto != nullptr ? salto : fin;
+                procesarLinea(inicio, finLinea - inicio, udp, respuesta, marcaMs);
+                inicio = finLinea + 1;
+            }
+            if (!respuesta.empty()) {
+                sendto(udp->fd, respuesta.data(), respuesta.size(), MSG_NOSIGNAL,
+                       reinterpret_cast<sockaddr*>(&origen), largo);
+                respuesta.clear();
+            }
+        }
+    }
+
+    /**
+     * @brief Ciclo de eventos (corre en el hilo del servidor)
+     */
+    void ciclo() {
+        epoll_event eventos[MAX_EVENTOS];
+        while (corriendo.load()) {
+            // Con lecturas retenidas se espera a lo sumo el retraso tolerado
+            int espera = -1;
+            if (reordenar && reordenador.getPendientes() > 0) {
+                long long retraso = reordenador.getRetrasoMs();
+                espera = retraso < ESPERA_MAXIMA_MS ? static_cast<int>(retraso) : ESPERA_MAXIMA_MS;
+            }
+            int n = epoll_wait(epollFd, eventos, MAX_EVENTOS, espera);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            if (n == 0) {
+                entregarReordenadas(true);  // Fuentes en silencio
+                continue;
+            }
+            for (int i = 0; i < n; i++) {
+                Canal* canal = static_cast<Canal*>(eventos[i].data.ptr);
+                unsigned int ev = eventos[i].events;
+
+                if (canal->tipo == CANAL_AVISO) {
+                    corriendo.store(false);
+                } else if (canal->tipo == CANAL_ESCUCHA) {
+                    aceptar();
+                } else if (canal->tipo == CANAL_UDP) {
+                    leerUdp();
+                } else {
+                    bool viva = true;
+                    if (ev & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                        viva = leerConexion(canal);
+                    }
+                    if (!canal->salida.empty()) {
+                        viva = vaciarSalida(canal) && viva;
+                    }
+                    // Un cliente que no lee sus respuestas no puede retener memoria sin límite
+                    if (canal->salida.size() >= CAPACIDAD_SALIDA) {
+                        viva = false;
+                    }
+                    if (!viva) {
+                        cerrar(canal);
+                    }
+                }
+            }
+            entregarReordenadas(false);
+            // Desalojo incremental: trabajo acotado por cada lote de eventos
+            lista.desalojar(ListaGestion::DESALOJOS_POR_PASO);
+        }
+    }
+
+    /**
+     * @brief Cierra todos los descriptores
+     */
+    void liberar() {
+        while (!conexiones.empty()) {
+            cerrar(*conexiones.begin());
+        }
+        if (udp != nullptr) reordenador.cerrarFuente(udp->fuente);
+        Canal* propios[3] = { escucha, udp, aviso };
+        for (int i = 0; i < 3; i++) {
+            if (propios[i] != nullptr) {
+                close(propios[i]->fd);
+                delete propios[i];
+            }
+        }
+        escucha = udp = aviso = nullptr;
+        if (reserva >= 0) close(reserva);
+        reserva = -1;
+        if (epollFd >= 0) close(epollFd);
+        epollFd = -1;
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param l Lista que recibirá las lecturas
+     */
+    explicit ServidorIngesta(ListaGestion& l)
+        : lista(l), epollFd(-1), escucha(nullptr), udp(nullptr), aviso(nullptr), reserva(-1),
+          corriendo(false), tramas(0), bytes(0), aceptadas(0), rechazadas(0), abiertas(0),
+          puertoTcp(0), puertoUdp(0), reordenar(false) {}
+
+    /**
+     * @brief Detiene el servidor si está activo
+     */
+    ~ServidorIngesta() {
+        detener();
+    }
+
+    /**
+     * @brief Abre los sockets en 127.0.0.1 e inicia el hilo de eventos
+     * @param tcp Puerto TCP (0 = cualquiera libre)
+     * @param puertoDatagramas Puerto UDP (0 = cualquiera libre)
+     * @return true si el servidor quedó escuchando
+     *
+     * Mientras el servidor corre, solo su hilo debe modificar la lista.
+     */
+    bool iniciar(unsigned short tcp, unsigned short puertoDatagramas) {
+        if (corriendo.load()) return false;
+
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        int fdTcp = abrirSocket(SOCK_STREAM, tcp, puertoTcp);
+        int fdUdp = abrirSocket(SOCK_DGRAM, puertoDatagramas, puertoUdp);
+        int fdAviso = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        reserva = open("/dev/null", O_RDONLY | O_CLOEXEC);
+        escucha = fdTcp >= 0 ? new Canal(fdTcp, CANAL_ESCUCHA) : nullptr;
+        udp = fdUdp >= 0 ? new Canal(fdUdp, CANAL_UDP) : nullptr;
+        aviso = fdAviso >= 0 ? new Canal(fdAviso, CANAL_AVISO) : nullptr;
+        if (udp != nullptr) udp->fuente = reordenador.abrirFuente();
+
+        if (epollFd < 0 || escucha == nullptr || udp == nullptr || aviso == nullptr
+            || !registrar(escucha, EPOLLIN | EPOLLET)
+            || !registrar(udp, EPOLLIN | EPOLLET)
+            || !registrar(aviso, EPOLLIN)) {
+            if (fdTcp >= 0 && escucha == nullptr) close(fdTcp);
+            if (fdUdp >= 0 && udp == nullptr) close(fdUdp);
+            if (fdAviso >= 0 && aviso == nullptr) close(fdAviso);
+            liberar();
+            return false;
+        }
+
+        corriendo.store(true);
+        hilo = std::thread(&ServidorIngesta::ciclo, this);
+        return true;
+    }
+
+    /**
+     * @brief Detiene el ciclo de eventos y cierra todas las conexiones
+     */
+    void detener() {
+        if (hilo.joinable()) {
+            unsigned long long uno = 1;
+            ssize_t escrito = write(aviso->fd, &uno, sizeof(uno));
+            (void)escrito;
+            hilo.join();
+        }
+        corriendo.store(false);
+        entregarReordenadas(true);
+        liberar();
+    }
+
+    /**
+     * @brief Activa el orden por marca entre conexiones (antes de iniciar)
+     * @param retrasoMs Desorden tolerado en ms (0 = entregar al llegar)
+     * @param capacidad Máximo de lecturas retenidas
+     * @return false si el servidor está activo
+     */
+    bool configurarReorden(long long retrasoMs,
+                           std::size_t capacidad = ReordenadorLecturas::CAPACIDAD_POR_DEFECTO) {
+        if (corriendo.load()) return false;
+        reordenar = retrasoMs > 0;
+        reordenador.configurar(retrasoMs, capacidad);
+        return true;
+    }
+
+    /**
+     * @brief Estado del reordenador (consultar con el servidor detenido)
+     */
+    const ReordenadorLecturas& getReordenador() const {
+        return reordenador;
+    }
+
+    /**
+     * @brief Indica si el ciclo de eventos está activo
+     */
+    bool activo() const {
+        return corriendo.load();
+    }
+
+    /**
+     * @brief Puerto TCP en que escucha
+     */
+    unsigned short getPuertoTcp() const {
+        return puertoTcp;
+    }
+
+    /**
+     * @brief Puerto UDP en que escucha
+     */
+    unsigned short getPuertoUdp() const {
+        return puertoUdp;
+    }
+
+    /**
+     * @brief Tramas de datos procesadas (sin contar PING)
+     */
+    unsigned long long getTramas() const {
+        return tramas.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Bytes recibidos por TCP y UDP
+     */
+    unsigned long long getBytes() const {
+        return bytes.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Conexiones TCP aceptadas desde el inicio
+     */
+    unsigned long long getAceptadas() const {
+        return aceptadas.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Conexiones cerradas al aceptarlas por falta de descriptores
+     */
+    unsigned long long getRechazadas() const {
+        return rechazadas.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Conexiones TCP abiertas ahora
+     */
+    std::size_t getAbiertas() const {
+        return abiertas.load(std::memory_order_relaxed);
+    }
+};
+
+#endif
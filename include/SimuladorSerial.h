@@ -9,20 +9,36 @@
 #define SIMULADOR_SERIAL_H
 
 #include <iostream>
-#include <cstdlib>
 #include <ctime>
 #include <cstring>
+#include "GeneradorCarga.h"
 
 /**
  * @class SimuladorSerial
  * @brief Simula datos recibidos por puerto serial desde Arduino
  * 
  * Genera datos aleatorios en formato "TIPO:ID:VALOR" simulando
- * el comportamiento del sketch Arduino.
+ * el comportamiento del sketch Arduino. Para flotas grandes y pruebas
+ * de carga usar GeneradorCarga.
  */
 class SimuladorSerial {
 private:
-    bool inicializado;  ///< Estado de inicialización
+    bool inicializado;              ///< Estado de inicialización
+    GeneradorAleatorio aleatorio;   ///< PRNG propio (no usa rand())
+    
+    /**
+     * @brief Copia una trama al buffer respetando su tamaño
+     * @param buffer Destino
+     * @param tam Tamaño del buffer
+     * @param trama Trama completa
+     * @param largo Longitud de la trama
+     */
+    static void copiarTrama(char* buffer, int tam, const char* trama, int largo) {
+        if (tam <= 0) return;
+        if (largo >= tam) largo = tam - 1;
+        memcpy(buffer, trama, static_cast<size_t>(largo));
+        buffer[largo] = '\0';
+    }
     
 public:
     /**
@@ -30,12 +46,21 @@ public:
      */
     SimuladorSerial() : inicializado(false) {}
     
+    /**
+     * @brief Constructor con semilla fija (secuencia reproducible)
+     * @param semilla Semilla del PRNG
+     */
+    explicit SimuladorSerial(unsigned long long semilla)
+        : inicializado(true), aleatorio(semilla) {}
+    
     /**
      * @brief Inicializa el generador de números aleatorios
+     *
+     * Sin semilla explícita se usa la hora actual.
      */
     void inicializar() {
         if (!inicializado) {
-            srand(static_cast<unsigned int>(time(nullptr)));
+            aleatorio.sembrar(static_cast<unsigned long long>(time(nullptr)));
             inicializado = true;
         }
     }
@@ -46,8 +71,10 @@ public:
      * @param tam Tamaño del buffer
      */
     void generarTemperatura(char* buffer, int tam) {
-        float temp = 20.0f + (rand() % 100) / 10.0f;
-        snprintf(buffer, tam, "TEMP:T-001:%.1f", temp);
+        float temp = 20.0f + aleatorio.entero(100) / 10.0f;
+        char trama[GeneradorCarga::LONGITUD_MAXIMA_TRAMA] = "TEMP:T-001:";
+        int largo = 11 + FormatoTrama::escribirDecimal(trama + 11, temp);
+        copiarTrama(buffer, tam, trama, largo);
     }
     
     /**
@@ -56,8 +83,10 @@ public:
      * @param tam Tamaño del buffer
      */
     void generarPresion(char* buffer, int tam) {
-        int presion = 1000 + (rand() % 50);
-        snprintf(buffer, tam, "PRES:P-105:%d", presion);
+        int presion = 1000 + static_cast<int>(aleatorio.entero(50));
+        char trama[GeneradorCarga::LONGITUD_MAXIMA_TRAMA] = "PRES:P-105:";
+        int largo = 11 + FormatoTrama::escribirEntero(trama + 11, presion);
+        copiarTrama(buffer, tam, trama, largo);
     }
     
     /**
@@ -66,8 +95,10 @@ public:
      * @param tam Tamaño del buffer
      */
     void generarVibracion(char* buffer, int tam) {
-        int vibracion = rand() % 80;
-        snprintf(buffer, tam, "VIBR:V-201:%d", vibracion);
+        int vibracion = static_cast<int>(aleatorio.entero(80));
+        char trama[GeneradorCarga::LONGITUD_MAXIMA_TRAMA] = "VIBR:V-201:";
+        int largo = 11 + FormatoTrama::escribirEntero(trama + 11, vibracion);
+        copiarTrama(buffer, tam, trama, largo);
     }
     
     /**
@@ -76,7 +107,7 @@ public:
      * @param tam Tamaño del buffer
      */
     void generarLecturaAleatoria(char* buffer, int tam) {
-        int tipo = rand() % 3;
+        int tipo = static_cast<int>(aleatorio.entero(3));
         
         switch (tipo) {
             case 0:
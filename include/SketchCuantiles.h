@@ -0,0 +1,233 @@
+/**
+ * @file SketchCuantiles.h
+ * @brief Sketch KLL de tamaño acotado para cuantiles aproximados
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef SKETCH_CUANTILES_H
+#define SKETCH_CUANTILES_H
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+
+/**
+ * @class SketchCuantiles
+ * @brief Resumen de una secuencia que responde cuantiles sin guardarla
+ *
+ * Implementa el sketch KLL: los valores se acumulan en niveles; el
+ * nivel h representa cada elemento con peso 2^h. Cuando el sketch
+ * excede su capacidad, el nivel más bajo que esté lleno se ordena y
+ * se queda con uno de cada dos elementos, que suben al nivel siguiente.
+ * Las capacidades decrecen geométricamente hacia los niveles bajos,
+ * así que la memoria total es O(k) sin importar cuántas lecturas haya,
+ * con un error de rango del orden de 1/k.
+ *
+ * La mitad que se conserva alterna de forma determinista en cada
+ * nivel: mismas lecturas, mismo resultado.
+ */
+class SketchCuantiles {
+private:
+    std::vector<std::vector<float> > niveles;  ///< Elementos por nivel (peso 2^h)
+    std::vector<unsigned char> paridad;        ///< Mitad a conservar en la próxima compactación
+    std::vector<std::size_t> capacidades;      ///< Capacidad de cada nivel
+    std::size_t capacidadTotal;                ///< Suma de capacidades
+    std::size_t guardados;                     ///< Elementos en todos los niveles
+    unsigned long long total;                  ///< Lecturas resumidas
+    int k;                                     ///< Capacidad del nivel superior
+    float minimo;                              ///< Mínimo exacto
+    float maximo;                              ///< Máximo exacto
+
+    /**
+     * @brief Recalcula las capacidades (k * (2/3)^profundidad, mínimo 2)
+     *
+     * Solo cambia cuando se agrega un nivel.
+     */
+    void recalcularCapacidades() {
+        capacidades.resize(niveles.size());
+        capacidadTotal = 0;
+        double c = static_cast<double>(k);
+        for (std::size_t h = niveles.size(); h-- > 0;) {
+            capacidades[h] = c > 2.0 ? static_cast<std::size_t>(c + 0.5) : 2;
+            capacidadTotal += capacidades[h];
+            c *= 2.0 / 3.0;
+        }
+    }
+
+    /**
+     * @brief Agrega un nivel vacío en la cima
+     */
+    void agregarNivel() {
+        niveles.push_back(std::vector<float>());
+        paridad.push_back(0);
+        recalcularCapacidades();
+    }
+
+    /**
+     * @brief Sube la mitad de un nivel al siguiente
+     * @param h Nivel a compactar
+     */
+    void compactar(std::size_t h) {
+        if (h + 1 == niveles.size()) {
+            agregarNivel();
+        }
+        std::vector<float>& nivel = niveles[h];
+        std::vector<float>& superior = niveles[h + 1];
+
+        // Con tamaño impar, el último elemento se queda en este nivel
+        float sobrante = 0.0f;
+        bool impar = nivel.size() % 2 == 1;
+        if (impar) {
+            sobrante = nivel.back();
+            nivel.pop_back();
+        }
+
+        std::sort(nivel.begin(), nivel.end());
+        for (std::size_t i = paridad[h]; i < nivel.size(); i += 2) {
+            superior.push_back(nivel[i]);
+        }
+        paridad[h] ^= 1;
+        guardados -= nivel.size() / 2;
+
+        nivel.clear();
+        if (impar) nivel.push_back(sobrante);
+    }
+
+    /**
+     * @brief Compacta hasta volver a la capacidad total
+     */
+    void comprimir() {
+        while (guardados > capacidadTotal) {
+            for (std::size_t h = 0; h < niveles.size(); h++) {
+                if (niveles[h].size() >= capacidades[h]) {
+                    compactar(h);
+                    break;
+                }
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param precision k: más grande = más exacto y más memoria (mínimo 8)
+     */
+    explicit SketchCuantiles(int precision = 64)
+        : niveles(1), paridad(1, 0), capacidadTotal(0), guardados(0), total(0),
+          k(precision < 8 ? 8 : precision), minimo(0.0f), maximo(0.0f) {
+        recalcularCapacidades();
+    }
+
+    /**
+     * @brief Agrega un valor
+     * @param valor Lectura
+     *
+     * Costo amortizado O(log k) (ordenar un nivel cada ~k/2 inserciones).
+     */
+    void agregar(float valor) {
+        if (total == 0 || valor < minimo) minimo = valor;
+        if (total == 0 || valor > maximo) maximo = valor;
+        total++;
+
+        niveles[0].push_back(valor);
+        if (++guardados > capacidadTotal) {
+            comprimir();
+        }
+    }
+
+    /**
+     * @brief Combina otro sketch en este (p. ej. de otro fragmento o periodo)
+     * @param otro Sketch a combinar
+     */
+    void fusionar(const SketchCuantiles& otro) {
+        if (otro.total == 0) return;
+        if (total == 0 || otro.minimo < minimo) minimo = otro.minimo;
+        if (total == 0 || otro.maximo > maximo) maximo = otro.maximo;
+        total += otro.total;
+
+        while (niveles.size() < otro.niveles.size()) {
+            agregarNivel();
+        }
+        for (std::size_t h = 0; h < otro.niveles.size(); h++) {
+            niveles[h].insert(niveles[h].end(), otro.niveles[h].begin(), otro.niveles[h].end());
+        }
+        guardados += otro.guardados;
+        comprimir();
+    }
+
+    /**
+     * @brief Calcula varios cuantiles en una sola pasada
+     * @param fracciones Cuantiles pedidos en [0, 1], en orden creciente
+     * @param n Número de cuantiles
+     * @param resultados Salida: un valor por cuantil
+     */
+    void cuantiles(const double* fracciones, int n, float* resultados) const {
+        if (total == 0) {
+            for (int i = 0; i < n; i++) resultados[i] = 0.0f;
+            return;
+        }
+
+        std::vector<std::pair<float, unsigned long long> > ponderados;
+        ponderados.reserve(guardados);
+        for (std::size_t h = 0; h < niveles.size(); h++) {
+            for (std::size_t i = 0; i < niveles[h].size(); i++) {
+                ponderados.push_back(std::make_pair(niveles[h][i], 1ULL << h));
+            }
+        }
+        std::sort(ponderados.begin(), ponderados.end());
+
+        unsigned long long pesoTotal = 0;
+        for (std::size_t i = 0; i < ponderados.size(); i++) {
+            pesoTotal += ponderados[i].second;
+        }
+
+        std::size_t j = 0;
+        unsigned long long acumulado = 0;
+        for (int q = 0; q < n; q++) {
+            if (fracciones[q] <= 0.0) {
+                resultados[q] = minimo;
+                continue;
+            }
+            if (fracciones[q] >= 1.0) {
+                resultados[q] = maximo;
+                continue;
+            }
+            double objetivo = fracciones[q] * static_cast<double>(pesoTotal);
+            while (j < ponderados.size()
+                   && static_cast<double>(acumulado + ponderados[j].second) < objetivo) {
+                acumulado += ponderados[j].second;
+                j++;
+            }
+            resultados[q] = j < ponderados.size() ? ponderados[j].first : maximo;
+        }
+    }
+
+    /**
+     * @brief Cuantil aproximado
+     * @param fraccion Cuantil en [0, 1] (0.5 = mediana)
+     * @return Valor aproximado
+     */
+    float cuantil(double fraccion) const {
+        float resultado = 0.0f;
+        cuantiles(&fraccion, 1, &resultado);
+        return resultado;
+    }
+
+    /**
+     * @brief Lecturas resumidas
+     */
+    unsigned long long getTotal() const {
+        return total;
+    }
+
+    /**
+     * @brief Elementos que ocupan memoria actualmente
+     */
+    std::size_t getGuardados() const {
+        return guardados;
+    }
+};
+
+#endif
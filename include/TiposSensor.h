@@ -0,0 +1,343 @@
+/**
+ * @file TiposSensor.h
+ * @brief Rasgos de cada tipo de sensor y lista de tipos en tiempo de compilación
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ *
+ * Para agregar un tipo de sensor nuevo:
+ * 1. Agregar su valor a TipoSensor (antes de NUM_TIPOS_SENSOR).
+ * 2. Definir su estructura de rasgos (ver TraitsTemperatura).
+ * 3. Agregarla a TiposRegistrados en el mismo orden que TipoSensor.
+ *
+ * El resto (clase Sensor<Traits>, columnas de resumen, tablas de
+ * despacho por etiqueta y por tipo) se genera a partir de la lista.
+ */
+
+#ifndef TIPOS_SENSOR_H
+#define TIPOS_SENSOR_H
+
+#include <cstdlib>
+#include <cstddef>
+
+/**
+ * @enum TipoSensor
+ * @brief Tipos concretos de sensor (índice dentro de TiposRegistrados)
+ */
+enum TipoSensor {
+    TIPO_TEMPERATURA = 0,  ///< SensorTemperatura (float)
+    TIPO_PRESION,          ///< SensorPresion (int)
+    TIPO_VIBRACION,        ///< SensorVibracion (int)
+    NUM_TIPOS_SENSOR
+};
+
+/**
+ * @enum EstadoAlerta
+ * @brief Estado de alerta derivado del promedio
+ */
+enum EstadoAlerta {
+    ALERTA_NORMAL = 0,  ///< Dentro de límites
+    ALERTA_BAJA,        ///< Por debajo del límite inferior
+    ALERTA_ALTA,        ///< Por encima del límite superior
+    ALERTA_MODERADA     ///< Nivel intermedio (vibración)
+};
+
+/**
+ * @brief Empaqueta una etiqueta de 4 letras en un entero
+ */
+constexpr unsigned int codigoEtiqueta(char a, char b, char c, char d) {
+    return static_cast<unsigned int>(static_cast<unsigned char>(a))
+         | static_cast<unsigned int>(static_cast<unsigned char>(b)) << 8
+         | static_cast<unsigned int>(static_cast<unsigned char>(c)) << 16
+         | static_cast<unsigned int>(static_cast<unsigned char>(d)) << 24;
+}
+
+/**
+ * @brief Código de una etiqueta leída de una trama
+ * @param etiqueta Texto terminado en '\0'
+ * @return Código, o 0 si la etiqueta no tiene exactamente 4 caracteres
+ */
+inline unsigned int codigoEtiqueta(const char* etiqueta) {
+    for (int i = 0; i < 4; i++) {
+        if (etiqueta[i] == '\0') return 0;
+    }
+    if (etiqueta[4] != '\0') return 0;
+    return codigoEtiqueta(etiqueta[0], etiqueta[1], etiqueta[2], etiqueta[3]);
+}
+
+/**
+ * @struct TraitsTemperatura
+ * @brief Rasgos del sensor de temperatura (°C, float)
+ */
+struct TraitsTemperatura {
+    typedef float Valor;                                              ///< Tipo de lectura
+    static const TipoSensor tipo = TIPO_TEMPERATURA;                  ///< Tipo
+    static const unsigned int codigo = codigoEtiqueta('T', 'E', 'M', 'P');  ///< Etiqueta de trama
+
+    static const char* nombre() { return "TEMPERATURA"; }             ///< Encabezado en imprimirInfo
+    static const char* unidad() { return " C"; }                      ///< Sufijo del promedio
+    static const char* pedirValor() { return "Temperatura (C): "; }   ///< Texto del menú
+    static const char* ejemploId() { return "T-001"; }                ///< ID de ejemplo
+
+    /**
+     * @brief Convierte el texto de una trama
+     */
+    static Valor convertir(const char* texto) { return static_cast<Valor>(atof(texto)); }
+
+    /**
+     * @brief Clasifica un promedio (límites 15-30°C)
+     */
+    static EstadoAlerta evaluarAlerta(Valor promedio) {
+        if (promedio < 15.0f) return ALERTA_BAJA;
+        if (promedio > 30.0f) return ALERTA_ALTA;
+        return ALERTA_NORMAL;
+    }
+
+    /**
+     * @brief Mensaje para un estado de alerta
+     */
+    static const char* mensaje(EstadoAlerta estado) {
+        switch (estado) {
+            case ALERTA_BAJA: return "ALERTA: Temperatura baja";
+            case ALERTA_ALTA: return "ALERTA: Temperatura alta";
+            default:          return "Estado: Normal";
+        }
+    }
+};
+
+/**
+ * @struct TraitsPresion
+ * @brief Rasgos del sensor de presión (hPa, int)
+ */
+struct TraitsPresion {
+    typedef int Valor;                                                ///< Tipo de lectura
+    static const TipoSensor tipo = TIPO_PRESION;                      ///< Tipo
+    static const unsigned int codigo = codigoEtiqueta('P', 'R', 'E', 'S');  ///< Etiqueta de trama
+
+    static const char* nombre() { return "PRESION"; }                 ///< Encabezado en imprimirInfo
+    static const char* unidad() { return " hPa"; }                    ///< Sufijo del promedio
+    static const char* pedirValor() { return "Presion (hPa): "; }     ///< Texto del menú
+    static const char* ejemploId() { return "P-105"; }                ///< ID de ejemplo
+
+    /**
+     * @brief Convierte el texto de una trama
+     */
+    static Valor convertir(const char* texto) { return atoi(texto); }
+
+    /**
+     * @brief Clasifica un promedio (límites 980-1050 hPa)
+     */
+    static EstadoAlerta evaluarAlerta(Valor promedio) {
+        if (promedio < 980) return ALERTA_BAJA;
+        if (promedio > 1050) return ALERTA_ALTA;
+        return ALERTA_NORMAL;
+    }
+
+    /**
+     * @brief Mensaje para un estado de alerta
+     */
+    static const char* mensaje(EstadoAlerta estado) {
+        switch (estado) {
+            case ALERTA_BAJA: return "ALERTA: Presion baja (tormenta)";
+            case ALERTA_ALTA: return "ALERTA: Presion alta";
+            default:          return "Estado: Normal";
+        }
+    }
+};
+
+/**
+ * @struct TraitsVibracion
+ * @brief Rasgos del sensor de vibración (0-100, int)
+ */
+struct TraitsVibracion {
+    typedef int Valor;                                                ///< Tipo de lectura
+    static const TipoSensor tipo = TIPO_VIBRACION;                    ///< Tipo
+    static const unsigned int codigo = codigoEtiqueta('V', 'I', 'B', 'R');  ///< Etiqueta de trama
+
+    static const char* nombre() { return "VIBRACION"; }               ///< Encabezado en imprimirInfo
+    static const char* unidad() { return ""; }                        ///< Sufijo del promedio
+    static const char* pedirValor() { return "Vibracion (0-100): "; } ///< Texto del menú
+    static const char* ejemploId() { return "V-201"; }                ///< ID de ejemplo
+
+    /**
+     * @brief Convierte el texto de una trama
+     */
+    static Valor convertir(const char* texto) { return atoi(texto); }
+
+    /**
+     * @brief Clasifica un promedio (normal < 30, moderada < 60)
+     */
+    static EstadoAlerta evaluarAlerta(Valor promedio) {
+        if (promedio < 30) return ALERTA_NORMAL;
+        if (promedio < 60) return ALERTA_MODERADA;
+        return ALERTA_ALTA;
+    }
+
+    /**
+     * @brief Mensaje para un estado de alerta
+     */
+    static const char* mensaje(EstadoAlerta estado) {
+        switch (estado) {
+            case ALERTA_NORMAL:   return "Estado: Normal";
+            case ALERTA_MODERADA: return "ALERTA: Vibracion moderada";
+            default:              return "ALERTA: Vibracion alta - revisar!";
+        }
+    }
+};
+
+/**
+ * @struct ListaTipos
+ * @brief Lista de tipos en tiempo de compilación
+ */
+template <typename... Ts>
+struct ListaTipos {
+    static const std::size_t tamano = sizeof...(Ts);  ///< Número de tipos
+};
+
+/**
+ * @brief Tipos de sensor registrados, en el orden de TipoSensor
+ */
+typedef ListaTipos<TraitsTemperatura, TraitsPresion, TraitsVibracion> TiposRegistrados;
+
+/**
+ * @struct HashEtiqueta
+ * @brief Hash perfecto de etiquetas a una tabla de 16 posiciones
+ */
+struct HashEtiqueta {
+    static const unsigned int BITS = 4;              ///< log2 del tamaño de tabla
+    static const unsigned int TAMANO = 1u << BITS;   ///< Posiciones de la tabla
+
+    /**
+     * @brief Posición de un código en la tabla (Fibonacci hashing)
+     */
+    static constexpr unsigned int ranura(unsigned int codigo) {
+        return (codigo * 0x9E3779B1u) >> (32 - BITS);
+    }
+};
+
+/**
+ * @struct ColisionaCon
+ * @brief true si T comparte ranura con alguno de Resto
+ */
+template <typename T, typename... Resto>
+struct ColisionaCon {
+    static const bool valor = false;  ///< Caso base
+};
+
+template <typename T, typename U, typename... Resto>
+struct ColisionaCon<T, U, Resto...> {
+    static const bool valor = HashEtiqueta::ranura(T::codigo) == HashEtiqueta::ranura(U::codigo)
+                           || ColisionaCon<T, Resto...>::valor;  ///< Resultado
+};
+
+/**
+ * @struct SinColisiones
+ * @brief true si todas las etiquetas de la lista caen en ranuras distintas
+ */
+template <typename Lista>
+struct SinColisiones;
+
+template <>
+struct SinColisiones<ListaTipos<> > {
+    static const bool valor = true;  ///< Caso base
+};
+
+template <typename T, typename... Resto>
+struct SinColisiones<ListaTipos<T, Resto...> > {
+    static const bool valor = !ColisionaCon<T, Resto...>::valor
+                           && SinColisiones<ListaTipos<Resto...> >::valor;  ///< Resultado
+};
+
+static_assert(SinColisiones<TiposRegistrados>::valor,
+              "Dos etiquetas de sensor colisionan en HashEtiqueta: cambiar el multiplicador");
+static_assert(TiposRegistrados::tamano == NUM_TIPOS_SENSOR,
+              "TiposRegistrados debe tener un rasgo por cada TipoSensor");
+
+/**
+ * @class TablaPorEtiqueta
+ * @brief Despacho de una etiqueta de trama a Accion<Traits>::ejecutar
+ * @tparam Accion Plantilla con un miembro estático ejecutar
+ * @tparam Firma Tipo puntero a función de ejecutar
+ *
+ * Una búsqueda cuesta un hash y una sola comparación de enteros,
+ * sin importar cuántos tipos estén registrados.
+ */
+template <template <typename> class Accion, typename Firma, typename Lista = TiposRegistrados>
+class TablaPorEtiqueta;
+
+template <template <typename> class Accion, typename Firma, typename... Ts>
+class TablaPorEtiqueta<Accion, Firma, ListaTipos<Ts...> > {
+private:
+    unsigned int codigos[HashEtiqueta::TAMANO];  ///< Código esperado por ranura
+    Firma funciones[HashEtiqueta::TAMANO];       ///< Función por ranura
+
+    /**
+     * @brief Coloca una función en su ranura
+     */
+    int colocar(unsigned int codigo, Firma funcion) {
+        codigos[HashEtiqueta::ranura(codigo)] = codigo;
+        funciones[HashEtiqueta::ranura(codigo)] = funcion;
+        return 0;
+    }
+
+public:
+    /**
+     * @brief Construye la tabla a partir de la lista de tipos
+     */
+    TablaPorEtiqueta() {
+        for (unsigned int i = 0; i < HashEtiqueta::TAMANO; i++) {
+            codigos[i] = 0;
+            funciones[i] = nullptr;
+        }
+        int expansion[] = { 0, colocar(Ts::codigo, &Accion<Ts>::ejecutar)... };
+        (void)expansion;
+    }
+
+    /**
+     * @brief Busca la función de una etiqueta
+     * @param codigo Código de la etiqueta (ver codigoEtiqueta)
+     * @return Función, o nullptr si la etiqueta no está registrada
+     */
+    Firma buscar(unsigned int codigo) const {
+        unsigned int r = HashEtiqueta::ranura(codigo);
+        return codigos[r] == codigo && codigo != 0 ? funciones[r] : nullptr;
+    }
+};
+
+/**
+ * @class TablaPorTipo
+ * @brief Despacho de un TipoSensor a Accion<Traits>::ejecutar (acceso directo)
+ */
+template <template <typename> class Accion, typename Firma, typename Lista = TiposRegistrados>
+class TablaPorTipo;
+
+template <template <typename> class Accion, typename Firma, typename... Ts>
+class TablaPorTipo<Accion, Firma, ListaTipos<Ts...> > {
+private:
+    Firma funciones[NUM_TIPOS_SENSOR];  ///< Función por tipo
+
+    /**
+     * @brief Coloca una función en la posición de su tipo
+     */
+    int colocar(TipoSensor tipo, Firma funcion) {
+        funciones[tipo] = funcion;
+        return 0;
+    }
+
+public:
+    /**
+     * @brief Construye la tabla a partir de la lista de tipos
+     */
+    TablaPorTipo() {
+        int expansion[] = { 0, colocar(Ts::tipo, &Accion<Ts>::ejecutar)... };
+        (void)expansion;
+    }
+
+    /**
+     * @brief Función asociada a un tipo
+     */
+    Firma operator[](TipoSensor tipo) const {
+        return funciones[tipo];
+    }
+};
+
+#endif
@@ -0,0 +1,309 @@
+/**
+ * @file VentanaDeslizante.h
+ * @brief Agregados sobre las últimas N lecturas o los últimos T milisegundos
+ * @author Carlos Vargas
+ * @date 30 de octubre de 2025
+ */
+
+#ifndef VENTANA_DESLIZANTE_H
+#define VENTANA_DESLIZANTE_H
+
+#include <vector>
+#include <cstddef>
+#include <chrono>
+#include "RegistroSensores.h"
+
+/**
+ * @brief Milisegundos de un reloj monótono (marca de tiempo de lecturas)
+ */
+inline long long ahoraMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Nanosegundos del mismo reloj monótono (para medir esperas)
+ */
+inline long long ahoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @class VentanaDeslizante
+ * @brief Promedio, mínimo y máximo de una ventana con costo O(1) amortizado
+ * @tparam T Tipo de la lectura
+ *
+ * La ventana conserva como máximo maxLecturas lecturas y, si
+ * maxDuracionMs > 0, solo las de los últimos maxDuracionMs respecto de
+ * la lectura más reciente. La suma se ajusta restando lo que sale; el
+ * mínimo y el máximo salen de dos colas monótonas, donde cada lectura
+ * entra y sale a lo sumo una vez.
+ *
+ * Las lecturas y las dos colas viven en anillos de capacidad fija
+ * (maxLecturas), reservados una sola vez: la lectura número k ocupa la
+ * celda k % maxLecturas y las colas guardan esas celdas. Con la ventana
+ * por defecto son 768 bytes por sensor para float o int.
+ */
+template <typename T>
+class VentanaDeslizante {
+private:
+    typedef typename Acumulador<T>::tipo TipoSuma;  ///< Tipo de la suma
+
+    /**
+     * @struct Muestra
+     * @brief Lectura dentro de la ventana
+     */
+    struct Muestra {
+        T valor;                     ///< Lectura
+        long long marcaMs;           ///< Marca de tiempo
+
+        Muestra() : valor(), marcaMs(0) {}
+    };
+
+    /**
+     * @struct ColaMonotona
+     * @brief Cola circular de celdas de muestras, dentro de su región de candidatos
+     */
+    struct ColaMonotona {
+        std::size_t region;          ///< Primera posición de la región en candidatos
+        std::size_t inicio;          ///< Frente, relativo a la región
+        std::size_t tam;             ///< Celdas guardadas
+    };
+
+    std::vector<Muestra> muestras;          ///< Anillo de lecturas (capacidad maxLecturas)
+    std::vector<unsigned int> candidatos;   ///< Regiones de minimos y maximos (maxLecturas cada una)
+    ColaMonotona minimos;           ///< Candidatos a mínimo (valores crecientes)
+    ColaMonotona maximos;           ///< Candidatos a máximo (valores decrecientes)
+    TipoSuma suma;                  ///< Suma de la ventana
+    std::size_t maxLecturas;        ///< Límite por cantidad (capacidad de los anillos)
+    long long maxDuracionMs;        ///< Límite por tiempo (0 = sin límite)
+    unsigned long long primero;     ///< Número de la lectura más vieja en la ventana
+    unsigned long long siguiente;   ///< Número de la próxima lectura
+
+    /**
+     * @brief Celda del frente de una cola
+     */
+    unsigned int frente(const ColaMonotona& cola) const {
+        return candidatos[cola.region + cola.inicio];
+    }
+
+    /**
+     * @brief Celda del fondo de una cola
+     */
+    unsigned int fondo(const ColaMonotona& cola) const {
+        return candidatos[cola.region + (cola.inicio + cola.tam - 1) % maxLecturas];
+    }
+
+    /**
+     * @brief Agrega una celda al fondo de una cola
+     */
+    void empujar(ColaMonotona& cola, unsigned int celda) {
+        candidatos[cola.region + (cola.inicio + cola.tam) % maxLecturas] = celda;
+        cola.tam++;
+    }
+
+    /**
+     * @brief Quita la celda del frente de una cola
+     */
+    void quitarFrente(ColaMonotona& cola) {
+        cola.inicio = (cola.inicio + 1) % maxLecturas;
+        cola.tam--;
+    }
+
+    /**
+     * @brief Reserva los anillos y deja la ventana vacía
+     * @param lecturas Capacidad (mínimo 1)
+     */
+    void reservar(std::size_t lecturas) {
+        maxLecturas = lecturas == 0 ? 1 : lecturas;
+        muestras.assign(maxLecturas, Muestra());
+        candidatos.assign(2 * maxLecturas, 0);
+        minimos.region = 0;
+        maximos.region = maxLecturas;
+        minimos.inicio = minimos.tam = 0;
+        maximos.inicio = maximos.tam = 0;
+        suma = 0;
+        primero = siguiente = 0;
+    }
+
+    /**
+     * @brief Ubica una lectura en la celda siguiente (debe haber lugar)
+     * @param valor Lectura
+     * @param marcaMs Marca de tiempo
+     */
+    void insertar(T valor, long long marcaMs) {
+        unsigned int celda = static_cast<unsigned int>(siguiente % maxLecturas);
+        muestras[celda].valor = valor;
+        muestras[celda].marcaMs = marcaMs;
+        siguiente++;
+
+        suma += valor;
+        while (minimos.tam > 0 && !(muestras[fondo(minimos)].valor < valor)) minimos.tam--;
+        empujar(minimos, celda);
+        while (maximos.tam > 0 && !(valor < muestras[fondo(maximos)].valor)) maximos.tam--;
+        empujar(maximos, celda);
+    }
+
+    /**
+     * @brief Saca la lectura más vieja
+     */
+    void expulsar() {
+        unsigned int celda = static_cast<unsigned int>(primero % maxLecturas);
+        suma -= muestras[celda].valor;
+        if (minimos.tam > 0 && frente(minimos) == celda) quitarFrente(minimos);
+        if (maximos.tam > 0 && frente(maximos) == celda) quitarFrente(maximos);
+        primero++;
+    }
+
+public:
+    /**
+     * @brief Constructor
+     * @param lecturas Máximo de lecturas en la ventana (mínimo 1)
+     * @param duracionMs Antigüedad máxima en ms (0 = sin límite)
+     */
+    explicit VentanaDeslizante(std::size_t lecturas = 32, long long duracionMs = 0)
+        : suma(0), maxLecturas(1), maxDuracionMs(duracionMs), primero(0), siguiente(0) {
+        reservar(lecturas);
+    }
+
+    /**
+     * @brief Agrega una lectura y expulsa las que quedan fuera
+     * @param valor Lectura
+     * @param marcaMs Marca de tiempo (no decreciente)
+     */
+    void agregar(T valor, long long marcaMs) {
+        if (cantidad() == maxLecturas) {
+            expulsar();  // Libera la celda que ocupará la nueva
+        }
+        insertar(valor, marcaMs);
+        expirar(marcaMs);
+    }
+
+    /**
+     * @brief Expulsa las lecturas más viejas que maxDuracionMs respecto de un instante
+     * @param referenciaMs Instante de referencia
+     */
+    void expirar(long long referenciaMs) {
+        if (maxDuracionMs <= 0) return;
+        while (primero < siguiente
+               && muestras[primero % maxLecturas].marcaMs <= referenciaMs - maxDuracionMs) {
+            expulsar();
+        }
+    }
+
+    /**
+     * @brief Cambia los límites y los aplica de inmediato
+     * @param lecturas Máximo de lecturas (mínimo 1)
+     * @param duracionMs Antigüedad máxima en ms (0 = sin límite)
+     *
+     * Conserva las lecturas más recientes que entran en los límites
+     * nuevos; el tiempo se mide respecto de la lectura más nueva.
+     */
+    void configurar(std::size_t lecturas, long long duracionMs) {
+        std::size_t nuevas = lecturas == 0 ? 1 : lecturas;
+        std::size_t conservar = cantidad() < nuevas ? cantidad() : nuevas;
+        std::vector<Muestra> previas;
+        previas.reserve(conservar);
+        for (unsigned long long k = siguiente - conservar; k < siguiente; k++) {
+            previas.push_back(muestras[k % maxLecturas]);
+        }
+
+        reservar(nuevas);
+        maxDuracionMs = duracionMs;
+        for (std::size_t i = 0; i < previas.size(); i++) {
+            insertar(previas[i].valor, previas[i].marcaMs);
+        }
+        if (!previas.empty()) {
+            expirar(previas.back().marcaMs);
+        }
+    }
+
+    /**
+     * @brief Lecturas dentro de la ventana
+     */
+    std::size_t cantidad() const {
+        return static_cast<std::size_t>(siguiente - primero);
+    }
+
+    /**
+     * @brief Promedio de la ventana (T(0) si está vacía)
+     */
+    T promedio() const {
+        if (cantidad() == 0) return T(0);
+        return static_cast<T>(suma / static_cast<TipoSuma>(cantidad()));
+    }
+
+    /**
+     * @brief Mínimo de la ventana (T(0) si está vacía)
+     */
+    T minimo() const {
+        return minimos.tam == 0 ? T(0) : muestras[frente(minimos)].valor;
+    }
+
+    /**
+     * @brief Máximo de la ventana (T(0) si está vacía)
+     */
+    T maximo() const {
+        return maximos.tam == 0 ? T(0) : muestras[frente(maximos)].valor;
+    }
+
+    /**
+     * @brief Límite por cantidad
+     */
+    std::size_t getMaxLecturas() const {
+        return maxLecturas;
+    }
+
+    /**
+     * @brief Límite por tiempo (0 = sin límite)
+     */
+    long long getMaxDuracionMs() const {
+        return maxDuracionMs;
+    }
+};
+
+/**
+ * @class PromedioExponencial
+ * @brief Media móvil exponencial (EWMA): v = alfa * x + (1 - alfa) * v
+ */
+class PromedioExponencial {
+private:
+    double alfa;     ///< Peso de la lectura nueva, en (0, 1]
+    double valor;    ///< Media actual
+    bool iniciado;   ///< Ya recibió al menos una lectura
+
+public:
+    /**
+     * @brief Constructor
+     * @param a Peso de cada lectura nueva
+     */
+    explicit PromedioExponencial(double a = 0.2)
+        : alfa(a <= 0.0 || a > 1.0 ? 0.2 : a), valor(0.0), iniciado(false) {}
+
+    /**
+     * @brief Incorpora una lectura
+     * @param x Lectura
+     */
+    void agregar(double x) {
+        valor = iniciado ? alfa * x + (1.0 - alfa) * valor : x;
+        iniciado = true;
+    }
+
+    /**
+     * @brief Media actual (0 si no hay lecturas)
+     */
+    double getValor() const {
+        return valor;
+    }
+
+    /**
+     * @brief Cambia el peso de las lecturas nuevas
+     * @param a Peso en (0, 1]
+     */
+    void setAlfa(double a) {
+        if (a > 0.0 && a <= 1.0) alfa = a;
+    }
+};
+
+#endif
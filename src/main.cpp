@@ -15,9 +15,27 @@
 #include "../include/SensorVibracion.h"
 #include "../include/ListaGestion.h"
 #include "../include/SimuladorSerial.h"
+#include "../include/Metricas.h"
+#include "../include/GeneradorCarga.h"
+#include "../include/Ingesta.h"
+#include "../include/PoolHilos.h"
+#include "../include/ServidorIngesta.h"
+#include "../include/ClienteIngesta.h"
+#include "../include/SketchCuantiles.h"
+#include "../include/ExportadorColumnar.h"
+#include "../include/ReordenadorLecturas.h"
+#include "../include/Rangos.h"
+#include <sys/resource.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <thread>
 
 using namespace std;
 
+const int OPCION_SALIR = 8;   ///< Opción del menú que termina el programa (la misma desde la primera versión)
+
 void mostrarMenu() {
     cout << "\n=== Sistema IoT de Sensores ===" << endl;
     cout << "1. Crear Sensor Temperatura" << endl;
@@ -27,64 +45,751 @@ void mostrarMenu() {
     cout << "5. Simular Arduino (5 lecturas)" << endl;
     cout << "6. Procesar Sensores" << endl;
     cout << "7. Mostrar Sensores" << endl;
-    cout << "8. Salir" << endl;
+    cout << OPCION_SALIR << ". Salir" << endl;
+    cout << "9. Mostrar Metricas" << endl;
+    cout << "10. Exportar Metricas (Prometheus)" << endl;
+    cout << "11. Generador de Carga" << endl;
+    cout << "12. Resumen de Flota" << endl;
+    cout << "13. Benchmark Procesamiento Paralelo" << endl;
+    cout << "14. Servidor de Ingesta (TCP/UDP)" << endl;
+    cout << "15. Benchmark Servidor de Ingesta" << endl;
+    cout << "16. Eliminar Sensor" << endl;
+    cout << "17. Configurar Desalojo de Sensores" << endl;
+    cout << "18. Ranking de Sensores (Top-K)" << endl;
+    cout << "19. Consultar Ubicacion" << endl;
+    cout << "20. Exportar Historiales (columnar/CSV)" << endl;
+    cout << "21. Leer Exportacion Columnar" << endl;
+    cout << "22. Benchmark Reordenamiento de Lecturas" << endl;
+    cout << "23. Analitica de Historiales (paralela)" << endl;
+    cout << "24. Activar/Desactivar Medicion de Latencias" << endl;
     cout << "Opcion: ";
 }
 
-void procesarDatoArduino(char* buffer, ListaGestion& listaGestion) {
-    char tipo[10] = "";
-    char id[20] = "";
-    char valor[20] = "";
+/**
+ * @brief Lee un número desde consola mostrando un mensaje
+ * @param mensaje Texto a mostrar
+ * @return Valor leído
+ */
+long long pedirNumero(const char* mensaje) {
+    long long valor = 0;
+    cout << mensaje;
+    cin >> valor;
+    cin.ignore();
+    return valor;
+}
+
+void procesarDatoArduino(char* buffer, ListaGestion& listaGestion, bool mostrar = true) {
+    TramaSensor trama;
     
-    // Dividir el string "TIPO:ID:VALOR"
-    char* token = strtok(buffer, ":");
-    if (token) strcpy(tipo, token);
+    Metricas::incrementar(CONTADOR_TRAMAS);
+    if (!parsearTrama(buffer, strlen(buffer), trama)) {
+        Metricas::incrementar(CONTADOR_TRAMAS_INVALIDAS);
+        if (mostrar) {
+            cout << "  Trama invalida: " << buffer << endl;
+        }
+        return;
+    }
     
-    token = strtok(nullptr, ":");
-    if (token) strcpy(id, token);
+    if (mostrar) {
+        cout << "  Dato Arduino: " << trama.tipo << " | " << trama.id << " | " << trama.valor << endl;
+    }
     
-    token = strtok(nullptr, ":");
-    if (token) strcpy(valor, token);
+    ingerirTrama(listaGestion, trama, "Arduino", trama.marca != 0 ? trama.marca : ahoraMs());
+}
+
+/**
+ * @brief Crea un sensor del tipo Traits con datos pedidos por consola
+ * @param listaGestion Lista destino
+ */
+template <typename Traits>
+void crearSensorMenu(ListaGestion& listaGestion) {
+    char id[50], ubicacion[50];
+    cout << "ID del sensor (ej: " << Traits::ejemploId() << "): ";
+    cin.getline(id, 50);
+    cout << "Ubicacion: ";
+    cin.getline(ubicacion, 50);
     
-    cout << "  Dato Arduino: " << tipo << " | " << id << " | " << valor << endl;
+    if (CrearSensor<Traits>::ejecutar(listaGestion, id, ubicacion) != nullptr) {
+        cout << "Sensor creado!\n";
+    } else {
+        cout << "Ya existe un sensor con ese ID!\n";
+    }
+}
+
+/**
+ * @struct LeerLecturaConsola
+ * @brief Pide una lectura por consola y la agrega a un sensor de tipo Traits
+ */
+template <typename Traits>
+struct LeerLecturaConsola {
+    static void ejecutar(SensorBase* sensor) {
+        typename Traits::Valor valor;
+        cout << Traits::pedirValor();
+        cin >> valor;
+        cin.ignore();
+        static_cast<Sensor<Traits>*>(sensor)->agregarLectura(valor);
+        cout << "Lectura agregada!\n";
+    }
+};
+
+/**
+ * @brief Ejecuta el generador de carga con parámetros pedidos por consola
+ * @param listaGestion Lista destino cuando se eligen tramas hacia el sistema
+ */
+void ejecutarGeneradorCarga(ListaGestion& listaGestion) {
+    ConfiguracionCarga config;
+    long long porTipo = pedirNumero("Sensores por tipo: ");
+    if (porTipo < 0) {
+        cout << "Cantidad invalida.\n";
+        return;
+    }
+    if (porTipo > GeneradorCarga::MAXIMO_SENSORES_POR_TIPO) {
+        porTipo = GeneradorCarga::MAXIMO_SENSORES_POR_TIPO;
+        cout << "Se usaran " << porTipo << " sensores por tipo.\n";
+    }
+    config.sensoresTemperatura = static_cast<int>(porTipo);
+    config.sensoresPresion = static_cast<int>(porTipo);
+    config.sensoresVibracion = static_cast<int>(porTipo);
+    unsigned long long tramas = static_cast<unsigned long long>(pedirNumero("Numero de tramas: "));
+    config.semilla = static_cast<unsigned long long>(pedirNumero("Semilla: "));
     
-    // Buscar sensor
-    SensorBase* sensor = listaGestion.buscarPorId(id);
+    cout << "Destino: 1=Memoria 2=Archivo 3=Pseudo-terminal 4=Sistema\n";
+    int destino = static_cast<int>(pedirNumero("Opcion: "));
     
-    // Si no existe, crearlo
-    if (sensor == nullptr) {
-        if (strcmp(tipo, "TEMP") == 0) {
-            sensor = new SensorTemperatura(id, "Arduino");
-            listaGestion.agregarSensor(sensor);
-        } else if (strcmp(tipo, "PRES") == 0) {
-            sensor = new SensorPresion(id, "Arduino");
-            listaGestion.agregarSensor(sensor);
-        } else if (strcmp(tipo, "VIBR") == 0) {
-            sensor = new SensorVibracion(id, "Arduino");
-            listaGestion.agregarSensor(sensor);
-        }
-        sensor = listaGestion.buscarPorId(id);
+    GeneradorCarga generador(config);
+    if (generador.getCantidadSensores() == 0 || tramas == 0) {
+        cout << "Nada que generar.\n";
+        return;
     }
     
-    // Agregar lectura según tipo
-    if (sensor) {
-        SensorTemperatura* temp = dynamic_cast<SensorTemperatura*>(sensor);
-        if (temp) {
-            temp->agregarLectura(atof(valor));
+    unsigned long long emitidas = 0;
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    
+    if (destino == 1) {
+        vector<char> buffer(1 << 16);
+        unsigned long long bytes = 0;
+        while (emitidas < tramas) {
+            unsigned long long lote = 0;
+            bytes += generador.generarLote(&buffer[0], buffer.size(), tramas - emitidas, lote);
+            emitidas += lote;
+        }
+        cout << "Bytes generados: " << bytes << "\n";
+    } else if (destino == 2) {
+        char ruta[200];
+        cout << "Archivo destino: ";
+        cin.getline(ruta, 200);
+        inicio = chrono::steady_clock::now();
+        emitidas = generador.escribirEnArchivo(ruta, tramas);
+    } else if (destino == 3) {
+        string esclavo;
+        int maestro = GeneradorCarga::abrirPty(esclavo);
+        if (maestro < 0) {
+            cout << "No se pudo abrir el pseudo-terminal\n";
             return;
         }
+        cout << "Conecte el lector a " << esclavo << " y presione Enter...";
+        cin.get();
+        inicio = chrono::steady_clock::now();
+        emitidas = generador.escribirEnDescriptor(maestro, tramas);
+        close(maestro);
+    } else if (destino == 4) {
+        char trama[GeneradorCarga::LONGITUD_MAXIMA_TRAMA + 1];
+        for (; emitidas < tramas; emitidas++) {
+            int n = generador.generarTrama(trama);
+            trama[n] = '\0';
+            procesarDatoArduino(trama, listaGestion, false);
+        }
+    } else {
+        cout << "Destino invalido.\n";
+        return;
+    }
+    
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    cout << "Tramas emitidas: " << emitidas << " en " << segundos << " s";
+    if (segundos > 0) {
+        cout << " (" << static_cast<unsigned long long>(emitidas / segundos) << " tramas/s)";
+    }
+    cout << "\n";
+}
+
+/**
+ * @brief Mide procesarTodosSensores con distinto número de hilos
+ * @param listaGestion Lista con los sensores a procesar
+ *
+ * Cada configuración se ejecuta varias veces y se reporta la mejor;
+ * la salida de cada modo paralelo se compara con la del modo serial.
+ */
+void ejecutarBenchmarkParalelo(ListaGestion& listaGestion) {
+    if (listaGestion.getCantidad() == 0) {
+        cout << "No hay sensores (use el Generador de Carga, destino 4).\n";
+        return;
+    }
+    
+    const int REPETICIONES = 3;
+    unsigned int maximo = static_cast<unsigned int>(pedirNumero("Hilos maximos (0 = nucleos): "));
+    if (maximo == 0) maximo = thread::hardware_concurrency();
+    if (maximo == 0) maximo = 1;
+    
+    // Potencias de dos hasta el máximo, y el máximo mismo
+    vector<unsigned int> configuraciones;
+    for (unsigned int hilos = 1; hilos < maximo; hilos *= 2) {
+        configuraciones.push_back(hilos);
+    }
+    configuraciones.push_back(maximo);
+    
+    ostringstream referencia;
+    listaGestion.procesarTodosSensores(referencia, nullptr);
+    const string esperado = referencia.str();
+    
+    cout << "\n=== Benchmark: " << listaGestion.getCantidad() << " sensores ===\n";
+    cout << "Hilos\tTiempo(ms)\tAceleracion\tSalida identica\n";
+    
+    double base = 0.0;
+    for (size_t c = 0; c < configuraciones.size(); c++) {
+        unsigned int hilos = configuraciones[c];
+        PoolHilos pool(hilos);
+        double mejor = 0.0;
+        bool identica = true;
         
-        SensorPresion* pres = dynamic_cast<SensorPresion*>(sensor);
-        if (pres) {
-            pres->agregarLectura(atoi(valor));
+        for (int r = 0; r < REPETICIONES; r++) {
+            ostringstream salida;
+            chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+            listaGestion.procesarTodosSensores(salida, &pool);
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+            if (r == 0 || ms < mejor) mejor = ms;
+            identica = identica && salida.str() == esperado;
+        }
+        
+        if (hilos == 1) base = mejor;
+        cout << hilos << "\t" << mejor << "\t\t" << (mejor > 0 ? base / mejor : 0.0)
+             << "x\t\t" << (identica ? "si" : "NO") << "\n";
+    }
+}
+
+/**
+ * @struct EstadisticaHistorial
+ * @brief Cantidad, suma, mínimo y máximo de un conjunto de lecturas
+ */
+struct EstadisticaHistorial {
+    long long lecturas;  ///< Lecturas consideradas
+    double suma;         ///< Suma de las lecturas
+    double minimo;       ///< Lectura mínima
+    double maximo;       ///< Lectura máxima
+    
+    EstadisticaHistorial() : lecturas(0), suma(0.0), minimo(0.0), maximo(0.0) {}
+};
+
+/**
+ * @struct CombinarEstadisticas
+ * @brief Reducción asociativa de dos EstadisticaHistorial
+ */
+struct CombinarEstadisticas {
+    EstadisticaHistorial operator()(const EstadisticaHistorial& a, const EstadisticaHistorial& b) const {
+        if (a.lecturas == 0) return b;
+        if (b.lecturas == 0) return a;
+        EstadisticaHistorial r;
+        r.lecturas = a.lecturas + b.lecturas;
+        r.suma = a.suma + b.suma;
+        r.minimo = a.minimo < b.minimo ? a.minimo : b.minimo;
+        r.maximo = a.maximo > b.maximo ? a.maximo : b.maximo;
+        return r;
+    }
+};
+
+/**
+ * @struct ResumirHistorial
+ * @brief Recorre el historial completo de un sensor de tipo Traits
+ */
+template <typename Traits>
+struct ResumirHistorial {
+    static EstadisticaHistorial ejecutar(SensorBase* sensor) {
+        EstadisticaHistorial r;
+        for (typename Traits::Valor valor : static_cast<Sensor<Traits>*>(sensor)->getLecturas()) {
+            double v = static_cast<double>(valor);
+            if (r.lecturas == 0 || v < r.minimo) r.minimo = v;
+            if (r.lecturas == 0 || v > r.maximo) r.maximo = v;
+            r.suma += v;
+            r.lecturas++;
+        }
+        return r;
+    }
+};
+
+/**
+ * @struct ResumirSensor
+ * @brief Transformación de la reducción: sensor -> estadística de su historial
+ */
+struct ResumirSensor {
+    EstadisticaHistorial operator()(SensorBase* sensor) const {
+        static const TablaPorTipo<ResumirHistorial, EstadisticaHistorial (*)(SensorBase*)> tabla;
+        return tabla[sensor->getTipo()](sensor);
+    }
+};
+
+/**
+ * @brief Recorre todos los historiales en serie y con el pool, y compara
+ * @param listaGestion Lista recorrida (no se modifica)
+ * @param pool Pool de hilos
+ *
+ * Es un análisis escrito desde fuera de los contenedores: solo usa los
+ * iteradores de ListaGestion y ListaSensor y reducirParalelo.
+ */
+void ejecutarAnaliticaHistoriales(const ListaGestion& listaGestion, PoolHilos& pool) {
+    if (listaGestion.getCantidad() == 0) {
+        cout << "No hay sensores (use el Generador de Carga, destino 4).\n";
+        return;
+    }
+    
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    EstadisticaHistorial serial = reducirParalelo(static_cast<PoolHilos*>(nullptr), listaGestion,
+                                                  EstadisticaHistorial(), CombinarEstadisticas(),
+                                                  ResumirSensor());
+    double msSerial = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+    
+    inicio = chrono::steady_clock::now();
+    EstadisticaHistorial paralelo = reducirParalelo(&pool, listaGestion, EstadisticaHistorial(),
+                                                    CombinarEstadisticas(), ResumirSensor());
+    double msParalelo = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+    
+    double diferencia = serial.suma - paralelo.suma;
+    if (diferencia < 0) diferencia = -diferencia;
+    double escala = serial.suma < 0 ? -serial.suma : serial.suma;
+    bool iguales = serial.lecturas == paralelo.lecturas && serial.minimo == paralelo.minimo
+                   && serial.maximo == paralelo.maximo && diferencia <= 1e-9 * (escala > 1.0 ? escala : 1.0);
+    
+    cout << "\n=== Historiales de " << listaGestion.getCantidad() << " sensores ===\n";
+    cout << "Lecturas: " << paralelo.lecturas
+         << " | Promedio: " << (paralelo.lecturas ? paralelo.suma / paralelo.lecturas : 0.0)
+         << " | Min: " << paralelo.minimo << " | Max: " << paralelo.maximo << "\n";
+    cout << "Serial: " << msSerial << " ms | " << pool.getNumHilos() << " hilos: " << msParalelo
+         << " ms (" << (msParalelo > 0 ? msSerial / msParalelo : 0.0) << "x) | Resultados iguales: "
+         << (iguales ? "si" : "NO") << "\n";
+}
+
+/**
+ * @brief Atiende pasarelas por TCP/UDP hasta que se presione Enter
+ * @param listaGestion Lista que recibe las lecturas
+ */
+void ejecutarServidorIngesta(ListaGestion& listaGestion) {
+    unsigned short tcp = static_cast<unsigned short>(pedirNumero("Puerto TCP (0 = libre): "));
+    unsigned short udp = static_cast<unsigned short>(pedirNumero("Puerto UDP (0 = libre): "));
+    long long retraso = pedirNumero("Retraso tolerado para tramas con marca, ms (0 = sin reordenar): ");
+    
+    unsigned long long duplicadasAntes = Metricas::leerContador(CONTADOR_TRAMAS_DUPLICADAS);
+    unsigned long long insertadasAntes = Metricas::leerContador(CONTADOR_LECTURAS_INSERTADAS);
+    unsigned long long tardiasAntes = Metricas::leerContador(CONTADOR_LECTURAS_TARDIAS);
+    ServidorIngesta servidor(listaGestion);
+    servidor.configurarReorden(retraso);
+    if (!servidor.iniciar(tcp, udp)) {
+        cout << "No se pudo iniciar el servidor\n";
+        return;
+    }
+    cout << "Escuchando en 127.0.0.1 TCP " << servidor.getPuertoTcp()
+         << " / UDP " << servidor.getPuertoUdp() << "\n";
+    cout << "Presione Enter para detener...";
+    cin.get();
+    servidor.detener();
+    
+    cout << "Tramas: " << servidor.getTramas() << " | Bytes: " << servidor.getBytes()
+         << " | Conexiones: " << servidor.getAceptadas()
+         << " | Rechazadas: " << servidor.getRechazadas()
+         << " | Duplicadas: " << Metricas::leerContador(CONTADOR_TRAMAS_DUPLICADAS) - duplicadasAntes << "\n";
+    if (retraso > 0) {
+        cout << "Reordenadas: " << servidor.getReordenador().getEntregadas() << " | ";
+    }
+    cout << "Tardias insertadas: " << Metricas::leerContador(CONTADOR_LECTURAS_INSERTADAS) - insertadasAntes
+         << " | Tardias descartadas: " << Metricas::leerContador(CONTADOR_LECTURAS_TARDIAS) - tardiasAntes << "\n";
+}
+
+/**
+ * @brief Sube el límite de descriptores abiertos si hace falta
+ * @param necesarios Descriptores requeridos
+ * @return true si el límite alcanza
+ */
+bool asegurarDescriptores(rlim_t necesarios) {
+    rlimit limite;
+    if (getrlimit(RLIMIT_NOFILE, &limite) != 0) return false;
+    if (limite.rlim_cur >= necesarios) return true;
+    if (limite.rlim_max != RLIM_INFINITY && limite.rlim_max < necesarios) return false;
+    limite.rlim_cur = necesarios;
+    return setrlimit(RLIMIT_NOFILE, &limite) == 0;
+}
+
+/**
+ * @brief Mide el servidor de ingesta con 1, 64 y 1024 conexiones TCP
+ *
+ * Cada conexión envía lotes de tramas seguidos de un PING; la latencia
+ * es el tiempo hasta el PONG, que el servidor envía después de
+ * procesar el lote. Las lecturas van a una lista aparte.
+ */
+void ejecutarBenchmarkIngesta() {
+    const int LOTE = 64;
+    const int HILOS_CLIENTE = 4;
+    const int conexiones[3] = { 1, 64, 1024 };
+    unsigned long long total = static_cast<unsigned long long>(pedirNumero("Tramas por configuracion: "));
+    if (total == 0) return;
+    
+    cout << "\nConexiones\tTramas/s\tLatencia p50(us)\tp99(us)\tRecibidas\n";
+    for (int c = 0; c < 3; c++) {
+        int numConexiones = conexiones[c];
+        if (!asegurarDescriptores(static_cast<rlim_t>(2 * numConexiones + 64))) {
+            cout << numConexiones << "\tlimite de descriptores insuficiente\n";
+            continue;
+        }
+        
+        ListaGestion destino;
+        ServidorIngesta servidor(destino);
+        if (!servidor.iniciar(0, 0)) {
+            cout << "No se pudo iniciar el servidor\n";
             return;
         }
         
-        SensorVibracion* vibr = dynamic_cast<SensorVibracion*>(sensor);
-        if (vibr) {
-            vibr->agregarLectura(atoi(valor));
+        unsigned long long porConexion = (total + numConexiones - 1) / numConexiones;
+        int numHilos = numConexiones < HILOS_CLIENTE ? numConexiones : HILOS_CLIENTE;
+        vector<SketchCuantiles> latencias(numHilos);
+        vector<char> fallos(numHilos, 0);
+        vector<thread> hilos;
+        
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        for (int h = 0; h < numHilos; h++) {
+            hilos.push_back(thread([&, h]() {
+                ConfiguracionCarga config;
+                config.semilla = static_cast<unsigned long long>(h + 1);
+                GeneradorCarga generador(config);
+                
+                // Conexiones h, h + numHilos, h + 2*numHilos...
+                vector<ClienteIngesta*> clientes;
+                for (int i = h; i < numConexiones; i += numHilos) {
+                    ClienteIngesta* cliente = new ClienteIngesta();
+                    if (!cliente->conectar(servidor.getPuertoTcp(), false)) fallos[h] = 1;
+                    clientes.push_back(cliente);
+                }
+                
+                for (unsigned long long enviadas = 0; enviadas < porConexion && !fallos[h]; enviadas += LOTE) {
+                    unsigned long long lote = porConexion - enviadas < LOTE ? porConexion - enviadas : LOTE;
+                    for (size_t i = 0; i < clientes.size(); i++) {
+                        long long ahora = chrono::duration_cast<chrono::nanoseconds>(
+                            chrono::steady_clock::now().time_since_epoch()).count();
+                        if (!clientes[i]->enviarTramas(generador, lote) || !clientes[i]->enviarPing(ahora)) {
+                            fallos[h] = 1;
+                        }
+                    }
+                    for (size_t i = 0; i < clientes.size() && !fallos[h]; i++) {
+                        long long enviado = 0;
+                        if (!clientes[i]->esperarPong(enviado)) {
+                            fallos[h] = 1;
+                            break;
+                        }
+                        long long ahora = chrono::duration_cast<chrono::nanoseconds>(
+                            chrono::steady_clock::now().time_since_epoch()).count();
+                        latencias[h].agregar(static_cast<float>((ahora - enviado) / 1000.0));
+                    }
+                }
+                
+                for (size_t i = 0; i < clientes.size(); i++) {
+                    delete clientes[i];
+                }
+            }));
+        }
+        for (size_t h = 0; h < hilos.size(); h++) {
+            hilos[h].join();
+        }
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        servidor.detener();
+        
+        bool fallo = false;
+        for (int h = 1; h < numHilos; h++) {
+            latencias[0].fusionar(latencias[h]);
+        }
+        for (int h = 0; h < numHilos; h++) {
+            fallo = fallo || fallos[h];
+        }
+        
+        unsigned long long recibidas = servidor.getTramas();
+        cout << numConexiones << "\t\t"
+             << static_cast<unsigned long long>(segundos > 0 ? recibidas / segundos : 0) << "\t\t"
+             << latencias[0].cuantil(0.50) << "\t\t\t" << latencias[0].cuantil(0.99) << "\t"
+             << recibidas << (fallo ? " (errores de conexion)" : "") << "\n";
+    }
+}
+
+/**
+ * @struct MedicionReorden
+ * @brief Resultados del benchmark de reordenamiento
+ */
+struct MedicionReorden {
+    SketchCuantiles esperaUs;           ///< Tiempo retenida en el reordenador (us)
+    SketchCuantiles retrasoMs;          ///< Distancia a la marca más alta al entregarse (ms)
+};
+
+/**
+ * @struct IngerirYMedir
+ * @brief Destino del benchmark: mide cada lectura entregada y la agrega a su sensor
+ */
+struct IngerirYMedir {
+    MedicionReorden& medicion;                 ///< Acumulador
+    const ReordenadorLecturas& reordenador;    ///< Etapa medida
+    ListaGestion& lista;                       ///< Sensores que reciben las lecturas
+    
+    IngerirYMedir(MedicionReorden& m, const ReordenadorLecturas& r, ListaGestion& l)
+        : medicion(m), reordenador(r), lista(l) {}
+    
+    void operator()(const LecturaPendiente& lectura) const {
+        long long marca = lectura.trama.marca;
+        medicion.esperaUs.agregar(static_cast<float>((ahoraNs() - lectura.llegadaNs) / 1000.0));
+        medicion.retrasoMs.agregar(static_cast<float>(reordenador.getMarcaMaxima() - marca));
+        ingerirTrama(lista, lectura.trama, "Benchmark", marca);
+    }
+};
+
+/**
+ * @struct HistorialOrdenado
+ * @brief Comprueba que el historial de un sensor de tipo Traits tenga marcas no decrecientes
+ */
+template <typename Traits>
+struct HistorialOrdenado {
+    static bool ejecutar(SensorBase* sensor) {
+        const ListaSensor<typename Traits::Valor>& lecturas =
+            static_cast<Sensor<Traits>*>(sensor)->getLecturas();
+        long long anterior = 0;
+        for (IteradorLista<typename Traits::Valor> it = lecturas.begin(); it != lecturas.end(); ++it) {
+            if (it.marca() < anterior) return false;
+            anterior = it.marca();
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Mide ReordenadorLecturas con 1, 8 y 64 fuentes
+ *
+ * Las lecturas son de 1000 sensores por tipo, ocurren a 16 por ms en
+ * total (unas 5 por segundo por sensor) y cada fuente las envía en orden
+ * con un atraso propio entre 0 y 1.5 veces el retraso tolerado; cada
+ * 4096 lecturas la fuente se "reconecta" (fuente nueva, atraso nuevo).
+ * Se mide agregar más liberar cada 64 lecturas, como en un lote de
+ * eventos del servidor, junto con la ingesta en los sensores. Se
+ * cuentan las lecturas que salieron detrás de otra ya entregada de su
+ * sensor y se insertaron en orden o se descartaron por caer fuera de
+ * la ventana de inserción, y se comprueba que todos los historiales
+ * queden ordenados.
+ */
+void ejecutarBenchmarkReorden() {
+    const int LOTE = 64;
+    const int LECTURAS_POR_MS = 16;
+    const int RECONEXION = 4096;
+    const long long MARCA_INICIAL = 1000000000LL;
+    const int SENSORES_POR_TIPO = 1000;
+    const int fuentesPorPrueba[3] = { 1, 8, 64 };
+    unsigned long long total = static_cast<unsigned long long>(pedirNumero("Lecturas por configuracion: "));
+    long long retraso = pedirNumero("Retraso tolerado (ms): ");
+    if (total == 0 || retraso <= 0) return;
+    
+    ConfiguracionCarga config;
+    config.sensoresTemperatura = SENSORES_POR_TIPO;
+    config.sensoresPresion = SENSORES_POR_TIPO;
+    config.sensoresVibracion = SENSORES_POR_TIPO;
+    GeneradorCarga generador(config);
+    vector<TramaSensor> tramas(total);
+    char texto[GeneradorCarga::LONGITUD_MAXIMA_TRAMA + 1];
+    for (unsigned long long i = 0; i < total; i++) {
+        int n = generador.generarTrama(texto);
+        parsearTrama(texto, static_cast<size_t>(n), tramas[i]);
+    }
+    
+    static const TablaPorTipo<HistorialOrdenado, bool (*)(SensorBase*)> ordenados;
+    cout << "\nFuentes\tLecturas/s\tEspera p50(us)\tp99(us)\tRetraso p99(ms)\tInsertadas\tDescartadas\tDesordenados\n";
+    for (int c = 0; c < 3; c++) {
+        int numFuentes = fuentesPorPrueba[c];
+        GeneradorAleatorio aleatorio(static_cast<unsigned long long>(c + 1));
+        ReordenadorLecturas reordenador(retraso);
+        ListaGestion lista;
+        vector<unsigned int> fuentes(numFuentes);
+        vector<long long> atrasos(numFuentes);
+        vector<int> enviadas(numFuentes, 0);
+        for (int f = 0; f < numFuentes; f++) {
+            fuentes[f] = reordenador.abrirFuente();
+            atrasos[f] = static_cast<long long>(aleatorio.uniforme() * 1.5 * retraso);
+        }
+        
+        MedicionReorden medicion;
+        IngerirYMedir ingerir(medicion, reordenador, lista);
+        unsigned long long insertadasAntes = Metricas::leerContador(CONTADOR_LECTURAS_INSERTADAS);
+        unsigned long long tardiasAntes = Metricas::leerContador(CONTADOR_LECTURAS_TARDIAS);
+        chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+        for (unsigned long long i = 0; i < total; i++) {
+            int f = static_cast<int>(aleatorio.entero(static_cast<unsigned int>(numFuentes)));
+            if (++enviadas[f] % RECONEXION == 0) {
+                reordenador.cerrarFuente(fuentes[f]);
+                fuentes[f] = reordenador.abrirFuente();
+                atrasos[f] = static_cast<long long>(aleatorio.uniforme() * 1.5 * retraso);
+            }
+            tramas[i].marca = MARCA_INICIAL + static_cast<long long>(i / LECTURAS_POR_MS) - atrasos[f];
+            reordenador.agregar(fuentes[f], tramas[i], ahoraNs());
+            if ((i + 1) % LOTE == 0) reordenador.liberar(ingerir);
+        }
+        reordenador.vaciar(ingerir);
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        
+        int desordenados = 0;
+        for (SensorBase* sensor : lista) {
+            if (!ordenados[sensor->getTipo()](sensor)) desordenados++;
         }
+        cout << numFuentes << "\t"
+             << static_cast<unsigned long long>(segundos > 0 ? total / segundos : 0) << "\t"
+             << medicion.esperaUs.cuantil(0.50) << "\t\t" << medicion.esperaUs.cuantil(0.99) << "\t"
+             << medicion.retrasoMs.cuantil(0.99) << "\t\t"
+             << Metricas::leerContador(CONTADOR_LECTURAS_INSERTADAS) - insertadasAntes << "\t\t"
+             << Metricas::leerContador(CONTADOR_LECTURAS_TARDIAS) - tardiasAntes << "\t\t"
+             << desordenados << "\n";
+    }
+}
+
+/**
+ * @brief Muestra los K sensores con mayor o menor valor de una estadística
+ * @param listaGestion Lista consultada
+ */
+void mostrarRanking(const ListaGestion& listaGestion) {
+    static const char* campos[NUM_CAMPOS_RANKING] = { "promedio", "maximo", "ultimo", "tasa/s" };
+    
+    cout << "Tipo: 1=Temperatura 2=Presion 3=Vibracion\n";
+    int tipo = static_cast<int>(pedirNumero("Opcion: ")) - 1;
+    cout << "Estadistica: 1=Promedio 2=Maximo 3=Ultimo 4=Tasa de cambio\n";
+    int campo = static_cast<int>(pedirNumero("Opcion: ")) - 1;
+    long long k = pedirNumero("Cantidad (K): ");
+    bool mayores = pedirNumero("Orden: 1=Mayores 2=Menores: ") != 2;
+    if (tipo < 0 || tipo >= NUM_TIPOS_SENSOR || campo < 0 || campo >= NUM_CAMPOS_RANKING || k <= 0) {
+        cout << "Parametros invalidos.\n";
+        return;
+    }
+    
+    vector<EntradaRanking> ranking;
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    listaGestion.ranking(static_cast<TipoSensor>(tipo), static_cast<CampoRanking>(campo),
+                         static_cast<size_t>(k), mayores, ranking);
+    double us = chrono::duration<double, micro>(chrono::steady_clock::now() - inicio).count();
+    
+    cout << "\n=== " << (mayores ? "Top " : "Bottom ") << k << " por " << campos[campo] << " ===\n";
+    for (size_t i = 0; i < ranking.size(); i++) {
+        cout << "  " << (i + 1) << ". " << ranking[i].sensor->getId()
+             << " (" << ranking[i].sensor->getUbicacion() << "): " << ranking[i].valor << "\n";
+    }
+    cout << "Consulta: " << us << " us\n";
+}
+
+/**
+ * @brief Muestra los resúmenes por tipo y los sensores de una ubicación
+ * @param listaGestion Lista consultada
+ */
+void consultarUbicacion(const ListaGestion& listaGestion) {
+    const size_t MAXIMO_LISTADO = 20;
+    static const char* nombres[NUM_TIPOS_SENSOR] = {
+        TraitsTemperatura::nombre(), TraitsPresion::nombre(), TraitsVibracion::nombre()
+    };
+    
+    char ubicacion[50];
+    cout << "Ubicacion: ";
+    cin.getline(ubicacion, 50);
+    
+    const ResumenUbicacion* resumen = listaGestion.buscarUbicacion(ubicacion);
+    if (resumen == nullptr) {
+        cout << "No hay sensores en esa ubicacion (" << listaGestion.getCantidadUbicaciones()
+             << " ubicaciones registradas)\n";
+        return;
+    }
+    
+    cout << "\n=== Ubicacion: " << resumen->ubicacion << " (" << resumen->sensores.size() << " sensores) ===\n";
+    for (int t = 0; t < NUM_TIPOS_SENSOR; t++) {
+        const ResumenTipoUbicacion& porTipo = resumen->porTipo[t];
+        if (porTipo.sensores == 0) continue;
+        cout << "  " << nombres[t] << ": " << porTipo.sensores << " sensores, "
+             << porTipo.lecturas << " lecturas";
+        if (porTipo.lecturas > 0) {
+            cout << ", promedio " << porTipo.promedio() << ", min " << porTipo.minimo
+                 << ", max " << porTipo.maximo;
+        }
+        cout << "\n";
+    }
+    
+    cout << "  Sensores:";
+    for (size_t i = 0; i < resumen->sensores.size() && i < MAXIMO_LISTADO; i++) {
+        cout << " " << resumen->sensores[i]->getId();
+    }
+    if (resumen->sensores.size() > MAXIMO_LISTADO) {
+        cout << " ... (" << resumen->sensores.size() - MAXIMO_LISTADO << " mas)";
     }
+    cout << "\n";
+}
+
+/**
+ * @brief Inicia la exportación de historiales en segundo plano
+ * @param listaGestion Lista a exportar
+ * @param exportador Exportador (una exportación a la vez)
+ */
+void exportarHistoriales(ListaGestion& listaGestion, ExportadorColumnar& exportador) {
+    if (exportador.activo()) {
+        cout << "Ya hay una exportacion en curso.\n";
+        return;
+    }
+    const ResultadoExportacion& anterior = exportador.esperar();
+    if (anterior.sensores > 0) {
+        cout << "Exportacion anterior: " << (anterior.exito ? "completa" : "FALLIDA") << ", "
+             << anterior.lecturas << " lecturas, " << anterior.bytes << " bytes en "
+             << anterior.segundos << " s";
+        if (anterior.segundos > 0) {
+            cout << " (" << anterior.bytes / anterior.segundos / 1e6 << " MB/s)";
+        }
+        cout << "\n";
+    }
+    
+    char ruta[200];
+    cout << "Archivo destino: ";
+    cin.getline(ruta, 200);
+    FormatoExportacion formato = pedirNumero("Formato: 1=Columnar 2=CSV: ") == 2
+        ? EXPORTAR_CSV : EXPORTAR_COLUMNAR;
+    
+    long long lecturas = exportador.iniciar(listaGestion, ruta, formato);
+    cout << "Exportando " << lecturas << " lecturas de " << listaGestion.getCantidad()
+         << " sensores en segundo plano\n";
+}
+
+/**
+ * @brief Abre una exportación columnar con mmap y resume sus columnas
+ */
+void leerExportacionColumnar() {
+    char ruta[200];
+    cout << "Archivo columnar: ";
+    cin.getline(ruta, 200);
+    
+    LectorColumnar lector;
+    if (!lector.abrir(ruta)) {
+        cout << "Archivo invalido o inexistente\n";
+        return;
+    }
+    
+    chrono::steady_clock::time_point inicio = chrono::steady_clock::now();
+    const uint64_t n = lector.getNumLecturas();
+    const int64_t* marcas = lector.columnaMarca();
+    const double* valores = lector.columnaValor();
+    double suma = 0.0;
+    int64_t primera = n ? marcas[0] : 0;
+    int64_t ultima = primera;
+    for (uint64_t i = 0; i < n; i++) {
+        suma += valores[i];
+        if (marcas[i] < primera) primera = marcas[i];
+        if (marcas[i] > ultima) ultima = marcas[i];
+    }
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+    
+    cout << "Sensores: " << lector.getNumSensores() << " | Lecturas: " << n << "\n";
+    cout << "Marcas: " << primera << " .. " << ultima << " ms | Promedio de valores: "
+         << (n ? suma / n : 0.0) << "\n";
+    const uint32_t* sensores = lector.columnaSensor();
+    for (uint64_t i = 0; i < n && i < 5; i++) {
+        cout << "  " << lector.id(sensores[i]) << " " << lector.etiqueta(sensores[i]) << " "
+             << marcas[i] << " " << valores[i] << "\n";
+    }
+    cout << "Barrido de columnas: " << ms << " ms\n";
 }
 
 int main() {
@@ -92,6 +797,9 @@ int main() {
     
     ListaGestion listaGestion;
     SimuladorSerial arduino;
+    ExportadorPrometheus exportador;
+    PoolHilos pool;
+    ExportadorColumnar exportadorHistoriales;
     int opcion = 0;
     
     do {
@@ -99,43 +807,22 @@ int main() {
         cin >> opcion;
         cin.ignore();
         
+        // Lo que llegó fuera de orden durante una exportación ya terminada
+        if (listaGestion.hayDiferidas()) aplicarLecturasDiferidas(listaGestion);
+        
         switch (opcion) {
             case 1: {
-                char id[50], ubicacion[50];
-                cout << "ID del sensor (ej: T-001): ";
-                cin.getline(id, 50);
-                cout << "Ubicacion: ";
-                cin.getline(ubicacion, 50);
-                
-                SensorBase* sensor = new SensorTemperatura(id, ubicacion);
-                listaGestion.agregarSensor(sensor);
-                cout << "Sensor creado!\n";
+                crearSensorMenu<TraitsTemperatura>(listaGestion);
                 break;
             }
             
             case 2: {
-                char id[50], ubicacion[50];
-                cout << "ID del sensor (ej: P-105): ";
-                cin.getline(id, 50);
-                cout << "Ubicacion: ";
-                cin.getline(ubicacion, 50);
-                
-                SensorBase* sensor = new SensorPresion(id, ubicacion);
-                listaGestion.agregarSensor(sensor);
-                cout << "Sensor creado!\n";
+                crearSensorMenu<TraitsPresion>(listaGestion);
                 break;
             }
             
             case 3: {
-                char id[50], ubicacion[50];
-                cout << "ID del sensor (ej: V-201): ";
-                cin.getline(id, 50);
-                cout << "Ubicacion: ";
-                cin.getline(ubicacion, 50);
-                
-                SensorBase* sensor = new SensorVibracion(id, ubicacion);
-                listaGestion.agregarSensor(sensor);
-                cout << "Sensor creado!\n";
+                crearSensorMenu<TraitsVibracion>(listaGestion);
                 break;
             }
             
@@ -144,44 +831,14 @@ int main() {
                 cout << "ID del sensor: ";
                 cin.getline(id, 50);
                 
-                SensorBase* sensor = listaGestion.buscarPorId(id);
+                SensorBase* sensor = buscarORecargar(listaGestion, id);
                 if (sensor == nullptr) {
                     cout << "Sensor no encontrado!\n";
                     break;
                 }
                 
-                // Intentar convertir a cada tipo
-                SensorTemperatura* temp = dynamic_cast<SensorTemperatura*>(sensor);
-                if (temp) {
-                    float valor;
-                    cout << "Temperatura (C): ";
-                    cin >> valor;
-                    cin.ignore();
-                    temp->agregarLectura(valor);
-                    cout << "Lectura agregada!\n";
-                    break;
-                }
-                
-                SensorPresion* pres = dynamic_cast<SensorPresion*>(sensor);
-                if (pres) {
-                    int valor;
-                    cout << "Presion (hPa): ";
-                    cin >> valor;
-                    cin.ignore();
-                    pres->agregarLectura(valor);
-                    cout << "Lectura agregada!\n";
-                    break;
-                }
-                
-                SensorVibracion* vibr = dynamic_cast<SensorVibracion*>(sensor);
-                if (vibr) {
-                    int valor;
-                    cout << "Vibracion (0-100): ";
-                    cin >> valor;
-                    cin.ignore();
-                    vibr->agregarLectura(valor);
-                    cout << "Lectura agregada!\n";
-                }
+                static const TablaPorTipo<LeerLecturaConsola, void (*)(SensorBase*)> lectores;
+                lectores[sensor->getTipo()](sensor);
                 break;
             }
             
@@ -200,7 +857,7 @@ int main() {
             }
             
             case 6: {
-                listaGestion.procesarTodosSensores();
+                listaGestion.procesarTodosSensores(cout, &pool);
                 break;
             }
             
@@ -209,7 +866,123 @@ int main() {
                 break;
             }
             
-            case 8: {
+            case 9: {
+                Metricas::imprimir();
+                break;
+            }
+            
+            case 10: {
+                char ruta[200];
+                int segundos = 0;
+                cout << "Archivo destino (ej: metricas.prom): ";
+                cin.getline(ruta, 200);
+                cout << "Intervalo en segundos (0 = solo una vez): ";
+                cin >> segundos;
+                cin.ignore();
+                
+                if (segundos > 0) {
+                    exportador.iniciar(ruta, segundos);
+                    cout << "Exportando cada " << segundos << " s a " << ruta << "\n";
+                } else {
+                    exportador.parar();
+                    if (Metricas::exportarPrometheus(string(ruta))) {
+                        cout << "Metricas exportadas a " << ruta << "\n";
+                    } else {
+                        cout << "No se pudo escribir " << ruta << "\n";
+                    }
+                }
+                break;
+            }
+            
+            case 11: {
+                ejecutarGeneradorCarga(listaGestion);
+                break;
+            }
+            
+            case 12: {
+                listaGestion.mostrarResumenFlota();
+                break;
+            }
+            
+            case 13: {
+                ejecutarBenchmarkParalelo(listaGestion);
+                break;
+            }
+            
+            case 14: {
+                ejecutarServidorIngesta(listaGestion);
+                break;
+            }
+            
+            case 15: {
+                ejecutarBenchmarkIngesta();
+                break;
+            }
+            
+            case 16: {
+                char id[50];
+                cout << "ID del sensor: ";
+                cin.getline(id, 50);
+                
+                if (listaGestion.eliminarSensor(id)) {
+                    cout << "Sensor eliminado!\n";
+                } else {
+                    cout << "Sensor no encontrado!\n";
+                }
+                break;
+            }
+            
+            case 17: {
+                char directorio[200];
+                int maximo = static_cast<int>(pedirNumero("Maximo de sensores en memoria (0 = sin limite): "));
+                long long inactividad = pedirNumero("Segundos sin tramas para desalojar (0 = nunca): ");
+                cout << "Directorio para guardar desalojados (vacio = descartar): ";
+                cin.getline(directorio, 200);
+                
+                listaGestion.configurarDesalojo(maximo, inactividad * 1000, directorio);
+                int desalojados = listaGestion.desalojar(listaGestion.getCantidad());
+                cout << "Desalojo configurado (" << desalojados << " sensores desalojados)\n";
+                break;
+            }
+            
+            case 18: {
+                mostrarRanking(listaGestion);
+                break;
+            }
+            
+            case 19: {
+                consultarUbicacion(listaGestion);
+                break;
+            }
+            
+            case 20: {
+                exportarHistoriales(listaGestion, exportadorHistoriales);
+                break;
+            }
+            
+            case 21: {
+                leerExportacionColumnar();
+                break;
+            }
+            
+            case 22: {
+                ejecutarBenchmarkReorden();
+                break;
+            }
+            
+            case 23: {
+                ejecutarAnaliticaHistoriales(listaGestion, pool);
+                break;
+            }
+            
+            case 24: {
+                bool activas = !Metricas::habilitadas().load();
+                Metricas::habilitadas().store(activas);
+                cout << "Medicion de latencias " << (activas ? "activada" : "desactivada") << "\n";
+                break;
+            }
+            
+            case OPCION_SALIR: {
                 cout << "\nCerrando sistema...\n";
                 break;
             }
@@ -218,7 +991,7 @@ int main() {
                 cout << "Opcion invalida.\n";
         }
         
-    } while (opcion != 8);
+    } while (opcion != OPCION_SALIR);
     
     cout << "\nSistema cerrado.\n";
     return 0;